@@ -0,0 +1,61 @@
+"""
+Measure the per-mutation cost of the activation side-table lookup.
+
+Every trampoline resolves hooks for `self` before doing anything else, so a
+list item assignment on a patched type is dominated by that lookup when no
+hook is registered for the operation.
+
+`operator.setitem` is used rather than `lst[i] = v` because the specializing
+interpreter rewrites the latter to STORE_SUBSCR_LIST_INT, which never reaches
+the mp_ass_subscript slot.
+
+    python3 benchmarks/activation_lookup.py
+"""
+import timeit
+
+from operator import setitem
+
+import _reaktome as _r
+
+
+NUMBER = 1_000_000
+REPEAT = 5
+
+
+def noop(*args):
+    pass
+
+
+def bench(label: str, stmt: str, setup: dict) -> None:
+    best = min(timeit.repeat(stmt, globals=setup, number=NUMBER, repeat=REPEAT))
+    print(f'{label:<40} {best / NUMBER * 1e9:8.1f} ns/op')
+
+
+def main() -> None:
+    baseline = [0] * 16
+    bench('list[i] = v (never patched)', 'setitem(lst, 3, 1)',
+          {'lst': baseline, 'setitem': setitem})
+
+    # Another activated list keeps the trampolines installed, but the
+    # side-table has no entry for this instance.
+    keep: list = []
+    _r.patch_list(keep, {'__reaktome_setitem__': noop})
+    inactive = [0] * 16
+    bench('list[i] = v (type patched, inactive)', 'setitem(lst, 3, 1)',
+          {'lst': inactive, 'setitem': setitem})
+
+    # Activated, but with no hook for the operation being performed.
+    other = [0] * 16
+    _r.patch_list(other, {'__reaktome_delitem__': noop})
+    bench('list[i] = v (active, no setitem hook)', 'setitem(lst, 3, 1)',
+          {'lst': other, 'setitem': setitem})
+
+    # Activated with a no-op hook.
+    active = [0] * 16
+    _r.patch_list(active, {'__reaktome_setitem__': noop})
+    bench('list[i] = v (active, no-op hook)', 'setitem(lst, 3, 1)',
+          {'lst': active, 'setitem': setitem})
+
+
+if __name__ == '__main__':
+    main()
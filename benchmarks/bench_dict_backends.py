@@ -0,0 +1,101 @@
+"""
+pyperf suite comparing the two dict backends on dicts nobody observes.
+
+Each case runs as `<case>[<backend>]`:
+
+    plain        nothing patched, the CPython baseline
+    trampolines  PyDict_Type patched, kept alive by one observed dict
+    watchers     one observed dict registered with PyDict_Watch
+
+The measured dict is never activated, so this is the cost that observing
+some dicts puts on every other dict in the process.
+
+    python3 benchmarks/bench_dict_backends.py -o backends.json
+"""
+from operator import setitem
+
+import pyperf
+
+import _reaktome as _r
+
+from common import noop
+
+
+BACKENDS = ('plain', 'trampolines', 'watchers')
+
+DICT_HOOKS = ('__reaktome_setitem__', '__reaktome_delitem__')
+
+_keepalive: list = []
+
+
+def prepare(backend: str) -> dict:
+    "Set up `backend` around one observed dict; return an unobserved one."
+    _keepalive.clear()
+    _r.unpatch_all()
+    if backend != 'plain':
+        _r.dict_backend(backend)
+        keep: dict = {}
+        _r.patch_dict(keep, {name: noop for name in DICT_HOOKS})
+        _keepalive.append(keep)
+    return {}
+
+
+def dict_setitem(loops: int, backend: str) -> float:
+    d = prepare(backend)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        setitem(d, i & 1023, i)
+    return pyperf.perf_counter() - t0
+
+
+def dict_store(loops: int, backend: str) -> float:
+    # specialized STORE_SUBSCR_DICT, which the trampolines never see
+    d = prepare(backend)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        d[i & 1023] = i
+    return pyperf.perf_counter() - t0
+
+
+def dict_update(loops: int, backend: str) -> float:
+    d = prepare(backend)
+    update, src = d.update, {str(i): i for i in range(8)}
+    t0 = pyperf.perf_counter()
+    for _ in range(loops):
+        update(src)
+    return pyperf.perf_counter() - t0
+
+
+def dict_pop(loops: int, backend: str) -> float:
+    d = prepare(backend)
+    for i in range(loops):
+        d[i] = i
+    pop = d.pop
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        pop(i)
+    return pyperf.perf_counter() - t0
+
+
+def dict_setdefault(loops: int, backend: str) -> float:
+    d = prepare(backend)
+    setdefault = d.setdefault
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        setdefault(i & 1023, i)
+    return pyperf.perf_counter() - t0
+
+
+CASES = (dict_setitem, dict_store, dict_update, dict_pop, dict_setdefault)
+
+
+def main() -> None:
+    runner = pyperf.Runner()
+    runner.metadata['description'] = 'reaktome dict backends, unobserved dicts'
+    for case in CASES:
+        for backend in BACKENDS:
+            runner.bench_time_func(f'{case.__name__}[{backend}]', case, backend)
+
+
+if __name__ == '__main__':
+    main()
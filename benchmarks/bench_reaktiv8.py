@@ -0,0 +1,82 @@
+"""
+pyperf suite for end-to-end change tracking on nested pydantic models.
+
+Uses the models from `tests/test_pydantic.py`, activated through the
+`Reaktome` mixin (`reaktiv8`) with a `Changes.on` listener, so each case
+covers trampoline, hook dispatch and the Python-side `Changes` plumbing.
+Models are built before the timer starts.
+
+    python3 benchmarks/bench_reaktiv8.py -o before.json
+    python3 -m pyperf compare_to before.json after.json --table
+"""
+import os
+import sys
+
+import pyperf
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from reaktome import Changes  # noqa: E402
+from tests.test_pydantic import (  # noqa: E402
+    FooModel, BarModel, BarModelCollection,
+)
+
+
+def tracked_bar() -> BarModel:
+    bar = BarModel(id='abc123', name='bar',
+                   foo=FooModel(id='xyz098', name='foo'))
+    Changes.on(bar, lambda change: None)
+    return bar
+
+
+def model_setattr(loops: int) -> float:
+    bar = tracked_bar()
+    names = ('a', 'b')
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        bar.name = names[i & 1]
+    return pyperf.perf_counter() - t0
+
+
+def nested_setattr(loops: int) -> float:
+    bar = tracked_bar()
+    names = ('a', 'b')
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        bar.foo.name = names[i & 1]
+    return pyperf.perf_counter() - t0
+
+
+def nested_replace(loops: int) -> float:
+    # Re-activates the new child and deactivates the old one each round.
+    bar = tracked_bar()
+    foos = (FooModel(id='1', name='a'), FooModel(id='2', name='b'))
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        bar.foo = foos[i & 1]
+    return pyperf.perf_counter() - t0
+
+
+def collection_append(loops: int) -> float:
+    coll = BarModelCollection()
+    Changes.on(coll, lambda change: None)
+    bars = [BarModel(id=str(i), name='bar') for i in range(loops)]
+    append = coll.append
+    t0 = pyperf.perf_counter()
+    for bar in bars:
+        append(bar)
+    return pyperf.perf_counter() - t0
+
+
+CASES = (model_setattr, nested_setattr, nested_replace, collection_append)
+
+
+def main() -> None:
+    runner = pyperf.Runner()
+    runner.metadata['description'] = 'reaktome end-to-end on pydantic models'
+    for case in CASES:
+        runner.bench_time_func(f'reaktiv8_{case.__name__}', case)
+
+
+if __name__ == '__main__':
+    main()
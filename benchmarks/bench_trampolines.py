@@ -0,0 +1,199 @@
+"""
+pyperf suite for the per-operation cost of the trampolines.
+
+Each case runs in the states described in `common.py` and is named
+`<type>_<op>[<state>]`, so `pyperf compare_to` lines up runs from different
+commits. Item assignment goes through `operator.setitem` because the
+specializing interpreter turns `lst[i] = v` / `d[k] = v` into
+STORE_SUBSCR_LIST_INT / STORE_SUBSCR_DICT, which never reach the slots.
+
+    python3 benchmarks/bench_trampolines.py -o before.json
+    python3 -m pyperf compare_to before.json after.json --table
+
+`make bench` runs this together with `bench_reaktiv8.py`.
+"""
+from operator import setitem
+
+import pyperf
+
+import _reaktome as _r
+
+from common import STATES, prepare
+
+# Dict cases measure the trampolines; see bench_dict_backends.py for watchers
+_r.dict_backend('trampolines')
+
+
+LIST_HOOKS = ('__reaktome_setitem__', '__reaktome_delitem__')
+DICT_HOOKS = ('__reaktome_setitem__', '__reaktome_delitem__')
+SET_HOOKS = ('__reaktome_additem__', '__reaktome_discarditem__',
+             '__reaktome_delitem__')
+OBJ_HOOKS = ('__reaktome_setattr__', '__reaktome_delattr__')
+
+
+class Point:
+    def __init__(self) -> None:
+        self.x = 0
+
+
+def list_append(loops: int, state: str) -> float:
+    lst = prepare(state, list, _r.patch_list, LIST_HOOKS)
+    append = lst.append
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        append(i)
+    return pyperf.perf_counter() - t0
+
+
+def list_extend(loops: int, state: str) -> float:
+    lst = prepare(state, list, _r.patch_list, LIST_HOOKS)
+    extend, chunk = lst.extend, (1, 2, 3)
+    t0 = pyperf.perf_counter()
+    for _ in range(loops):
+        extend(chunk)
+    return pyperf.perf_counter() - t0
+
+
+def list_setitem(loops: int, state: str) -> float:
+    lst = prepare(state, lambda: [0] * 16, _r.patch_list, LIST_HOOKS)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        setitem(lst, 3, i)
+    return pyperf.perf_counter() - t0
+
+
+def list_setslice(loops: int, state: str) -> float:
+    lst = prepare(state, lambda: [0] * 16, _r.patch_list, LIST_HOOKS)
+    where, chunk = slice(4, 8), (1, 2, 3, 4)
+    t0 = pyperf.perf_counter()
+    for _ in range(loops):
+        setitem(lst, where, chunk)
+    return pyperf.perf_counter() - t0
+
+
+def dict_setitem(loops: int, state: str) -> float:
+    d = prepare(state, dict, _r.patch_dict, DICT_HOOKS)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        setitem(d, i & 1023, i)
+    return pyperf.perf_counter() - t0
+
+
+def dict_update(loops: int, state: str) -> float:
+    d = prepare(state, dict, _r.patch_dict, DICT_HOOKS)
+    update, src = d.update, {str(i): i for i in range(8)}
+    t0 = pyperf.perf_counter()
+    for _ in range(loops):
+        update(src)
+    return pyperf.perf_counter() - t0
+
+
+def dict_pop(loops: int, state: str) -> float:
+    d = prepare(state, dict, _r.patch_dict, DICT_HOOKS)
+    for i in range(loops):
+        d[i] = i
+    pop = d.pop
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        pop(i)
+    return pyperf.perf_counter() - t0
+
+
+def dict_clear(loops: int, state: str) -> float:
+    # Times refill + clear: clear() needs something to remove each round.
+    d = prepare(state, dict, _r.patch_dict, DICT_HOOKS)
+    update, clear, src = d.update, d.clear, {str(i): i for i in range(8)}
+    t0 = pyperf.perf_counter()
+    for _ in range(loops):
+        update(src)
+        clear()
+    return pyperf.perf_counter() - t0
+
+
+def set_add(loops: int, state: str) -> float:
+    s = prepare(state, set, _r.patch_set, SET_HOOKS)
+    add = s.add
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        add(i)
+    return pyperf.perf_counter() - t0
+
+
+def set_discard(loops: int, state: str) -> float:
+    s = prepare(state, set, _r.patch_set, SET_HOOKS)
+    s.update(range(loops))
+    discard = s.discard
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        discard(i)
+    return pyperf.perf_counter() - t0
+
+
+def set_update(loops: int, state: str) -> float:
+    # Times refill + difference_update, one delta each way per round.
+    s = prepare(state, set, _r.patch_set, SET_HOOKS)
+    update, difference_update = s.update, s.difference_update
+    chunk = frozenset(range(8))
+    t0 = pyperf.perf_counter()
+    for _ in range(loops):
+        update(chunk)
+        difference_update(chunk)
+    return pyperf.perf_counter() - t0
+
+
+def obj_setattr(loops: int, state: str) -> float:
+    obj = prepare(state, Point, _r.patch_obj, OBJ_HOOKS)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        obj.x = i
+    return pyperf.perf_counter() - t0
+
+
+# The native subclasses run the same trampolines with the hooks in the
+# object; 'plain' is an unobserved instance with nothing installed anywhere.
+
+def native_list_append(loops: int, state: str) -> float:
+    lst = prepare(state, _r.ReaktomeList, _r.patch_list, LIST_HOOKS)
+    append = lst.append
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        append(i)
+    return pyperf.perf_counter() - t0
+
+
+def native_dict_setitem(loops: int, state: str) -> float:
+    d = prepare(state, _r.ReaktomeDict, _r.patch_dict, DICT_HOOKS)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        setitem(d, i & 1023, i)
+    return pyperf.perf_counter() - t0
+
+
+def native_set_add(loops: int, state: str) -> float:
+    s = prepare(state, _r.ReaktomeSet, _r.patch_set, SET_HOOKS)
+    add = s.add
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        add(i)
+    return pyperf.perf_counter() - t0
+
+
+CASES = (
+    list_append, list_extend, list_setitem, list_setslice,
+    dict_setitem, dict_update, dict_pop, dict_clear,
+    set_add, set_discard, set_update,
+    obj_setattr,
+    native_list_append, native_dict_setitem, native_set_add,
+)
+
+
+def main() -> None:
+    runner = pyperf.Runner()
+    runner.metadata['description'] = 'reaktome trampoline overhead'
+    for case in CASES:
+        for state in STATES:
+            runner.bench_time_func(f'{case.__name__}[{state}]', case, state)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,51 @@
+"""
+Shared helpers for the pyperf suites in this directory.
+
+Every trampoline case runs in three states:
+
+    plain     nothing patched (`unpatch_all()` first), the CPython baseline
+    inactive  the type's trampolines are installed (kept alive by another
+              activated instance) but the measured instance is not in the
+              side-table, so trampolines take the unobserved fast path
+    active    the measured instance is activated with no-op hooks
+"""
+from typing import Any, Callable
+
+import _reaktome as _r
+
+
+STATES = ('plain', 'inactive', 'active')
+
+# Activated instances holding each type's install while a worker runs an
+# 'inactive' case; without one the last deactivation uninstalls the type.
+_keepalive: list = []
+
+
+def noop(self: Any, key: Any, old: Any, new: Any) -> Any:
+    return new
+
+
+def prepare(state: str,
+            make: Callable[[], Any],
+            patch: Callable[[Any, Any], None],
+            hooks: tuple,
+            ) -> Any:
+    "Return a fresh instance from `make()` in the given state."
+    if state == 'plain':
+        _keepalive.clear()
+        _r.unpatch_all()
+        return make()
+
+    if state == 'inactive':
+        # the same hooks, so the same trampolines are installed
+        keep = make()
+        patch(keep, {name: noop for name in hooks})
+        _keepalive.append(keep)
+        return make()
+
+    if state == 'active':
+        inst = make()
+        patch(inst, {name: noop for name in hooks})
+        return inst
+
+    raise ValueError(f'Unknown state: {state}')
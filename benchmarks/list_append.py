@@ -0,0 +1,44 @@
+"""
+list.append storm on an activated list with a no-op hook.
+
+Isolates the cost of hook dispatch in reaktome_call_dunder/_hook: every
+append runs the trampoline and calls the hook once.
+
+    python3 benchmarks/list_append.py
+"""
+import timeit
+
+import _reaktome as _r
+
+
+NUMBER = 200_000
+REPEAT = 25
+
+
+def noop(self, key, old, new):
+    pass
+
+
+def storm(lst: list) -> float:
+    # clear() before each repeat keeps the list (and memory effects) small
+    times = timeit.repeat('append(1)', setup='clear()',
+                          globals={'append': lst.append, 'clear': lst.clear},
+                          number=NUMBER, repeat=REPEAT)
+    return min(times) / NUMBER * 1e9
+
+
+def main() -> None:
+    baseline: list = []
+    print(f'{"append (never patched)":<40} {storm(baseline):8.1f} ns/op')
+
+    active: list = []
+    _r.patch_list(active, {'__reaktome_setitem__': noop})
+    print(f'{"append (active, python hook)":<40} {storm(active):8.1f} ns/op')
+
+    builtin: list = []
+    _r.patch_list(builtin, {'__reaktome_setitem__': ''.format})
+    print(f'{"append (active, C hook)":<40} {storm(builtin):8.1f} ns/op')
+
+
+if __name__ == '__main__':
+    main()
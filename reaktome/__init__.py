@@ -28,6 +28,18 @@ LOGGER.addHandler(logging.NullHandler())
 
 SENTINAL = object()
 
+# C subclasses with the hooks built in: observing them patches nothing
+# global and never touches the side-table.
+ReaktomeList = _r.ReaktomeList
+ReaktomeDict = _r.ReaktomeDict
+ReaktomeSet = _r.ReaktomeSet
+
+NATIVE_TYPES = {
+    list: ReaktomeList,
+    dict: ReaktomeDict,
+    set: ReaktomeSet,
+}
+
 
 class Change:
     def __init__(self,
@@ -194,15 +206,50 @@ class Changes:
         changes.callbacks.append((ChangeFilter(pattern, regex=regex), cb))
 
 
+def slot_names(cls: type) -> tuple[str, ...]:
+    "Names of the __slots__ attributes declared along the MRO of cls."
+    names = []
+    for klass in cls.__mro__:
+        slots = klass.__dict__.get('__slots__', ())
+        if isinstance(slots, str):
+            slots = (slots,)
+        for slot in slots:
+            if slot in ('__dict__', '__weakref__'):
+                continue
+            if slot.startswith('__') and not slot.endswith('__'):
+                # Private names are mangled, as in the class body.
+                slot = f'_{klass.__name__.lstrip("_")}{slot}'
+            names.append(slot)
+    return tuple(names)
+
+
+def has_attrs(obj: Any) -> bool:
+    "True if obj stores attributes in a __dict__ or in __slots__."
+    return hasattr(obj, '__dict__') or bool(slot_names(type(obj)))
+
+
+def attrs(obj: Any) -> list[tuple[str, Any]]:
+    "The (name, value) pairs set on obj: __dict__ first, then __slots__."
+    items = list(getattr(obj, '__dict__', {}).items())
+    for name in slot_names(type(obj)):
+        value = getattr(obj, name, SENTINAL)
+        if value is not SENTINAL:
+            items.append((name, value))
+    return items
+
+
+def to_native(value: Any) -> Any:
+    "A plain list, dict or set copied into its native subclass; else value."
+    native = NATIVE_TYPES.get(type(value))
+    return value if native is None else native(value)
+
+
 def __reaktome_setattr__(self, name: str, old: Any, new: Any) -> None:
     "Used by Obj."
     LOGGER.debug(
         '__reaktome_setattr__(%s, %s, %s, %s)',
         repr(self), name, repr(old), repr(new),
     )
-    if name.startswith('_'):
-        LOGGER.debug('Skipping private/protected attr: %s', name)
-        return new
     reaktiv8(new, name, parent=self, source='attr')
     deaktiv8(old, name, parent=self, source='attr')
     Changes.invoke(Change(self, name, old, new, source='attr'))
@@ -215,9 +262,6 @@ def __reaktome_delattr__(self, name: str, old: Any, new: Any) -> None:
         '__reaktome_delattr__(%s, %s, %s, %s)',
         repr(self), name, repr(old), repr(new),
     )
-    if name.startswith('_'):
-        LOGGER.debug('Skipping private/protected attr: %s', name)
-        return
     deaktiv8(old, name, parent=self, source='attr')
     Changes.invoke(Change(self, name, old, None, source='attr'))
 
@@ -298,13 +342,21 @@ def reaktiv8(
     parent: Any = None,
     source: str = "attr",
     seen: Optional[set] = None,
+    native: Optional[bool] = None,
 ) -> None:
     """
     Activate reaktome hooks on an object instance and register it for change
     tracking.
+
+    With native (default: obj's __reaktome_native__ attribute), the plain
+    lists, dicts and sets obj holds are replaced by ReaktomeList,
+    ReaktomeDict and ReaktomeSet copies before they are activated, so the
+    builtin types are never patched.
     """
     if name is None:
         name = obj.__class__.__name__
+    if native is None:
+        native = bool(getattr(obj, '__reaktome_native__', False))
 
     seen = seen if seen else set()
     if id(obj) in seen:
@@ -313,6 +365,10 @@ def reaktiv8(
 
     if isinstance(obj, list):
         LOGGER.debug('Activating list: %s', repr(obj))
+        if native:
+            for i, child in enumerate(obj):
+                if type(child) in NATIVE_TYPES:
+                    obj[i] = to_native(child)
         _r.patch_list(obj, {
             "__reaktome_setitem__": __reaktome_setitem__,
             "__reaktome_delitem__": __reaktome_delitem__,
@@ -320,7 +376,8 @@ def reaktiv8(
         Changes.add_backref(obj, BackRef(parent, obj, name, source="item"))
         seen.add(id(obj))
         for i, child in enumerate(obj):
-            reaktiv8(child, name=i, parent=obj, source='item', seen=seen)
+            reaktiv8(child, name=i, parent=obj, source='item', seen=seen,
+                     native=native)
 
     elif isinstance(obj, set):
         LOGGER.debug('Activating set: %s', repr(obj))
@@ -332,10 +389,15 @@ def reaktiv8(
         Changes.add_backref(obj, BackRef(parent, obj, name, source="item"))
         seen.add(id(obj))
         for child in obj:
-            reaktiv8(child, parent=obj, source='item', seen=seen)
+            reaktiv8(child, parent=obj, source='item', seen=seen,
+                     native=native)
 
     elif isinstance(obj, dict):
         LOGGER.debug('Activating dict: %s', repr(obj))
+        if native:
+            for key, child in list(obj.items()):
+                if type(child) in NATIVE_TYPES:
+                    obj[key] = to_native(child)
         _r.patch_dict(obj, {
             "__reaktome_setitem__": __reaktome_setitem__,
             "__reaktome_delitem__": __reaktome_delitem__,
@@ -343,26 +405,36 @@ def reaktiv8(
         Changes.add_backref(obj, BackRef(parent, obj, name, source="item"))
         seen.add(id(obj))
         for key, child in obj.items():
-            reaktiv8(child, name=key, parent=obj, source='item', seen=seen)
+            reaktiv8(child, name=key, parent=obj, source='item', seen=seen,
+                     native=native)
 
-    elif hasattr(obj, "__dict__"):
+    elif has_attrs(obj):
         LOGGER.debug('Activating obj: %s', repr(obj))
+        if native:
+            for key, value in attrs(obj):
+                if type(value) in NATIVE_TYPES and not key.startswith('_'):
+                    # Bypass __setattr__: the value is the same, only its
+                    # type changes.
+                    object.__setattr__(obj, key, to_native(value))
         _r.patch_obj(obj, {
             "__reaktome_setattr__": __reaktome_setattr__,
             "__reaktome_delattr__": __reaktome_delattr__,
             "__reaktome_setitem__": __reaktome_setitem__,
             "__reaktome_delitem__": __reaktome_delitem__,
+            # private/protected attributes are dropped in C
+            "__reaktome_filter__": "_",
         })
         Changes.add_backref(obj, BackRef(parent, obj, name, source="attr"))
         seen.add(id(obj))
-        for name, value in obj.__dict__.items():
+        for name, value in attrs(obj):
             if not isinstance(name, int) and name.startswith('_'):
                 LOGGER.debug('Skipping private/protected attr: %s', name)
                 continue
             if ((BaseCollectionModel is not None and
                  isinstance(obj, BaseCollectionModel) and name == 'root')):
                 continue
-            reaktiv8(value, name=name, parent=obj, source='attr', seen=seen)
+            reaktiv8(value, name=name, parent=obj, source='attr', seen=seen,
+                     native=native)
 
     else:
         LOGGER.info('Unsupported type: %s', repr(obj))
@@ -399,7 +471,7 @@ def deaktiv8(
         _r.patch_dict(obj, None)
         Changes.del_backref(obj, BackRef(parent, obj, name, source))
 
-    elif hasattr(obj, "__dict__"):
+    elif has_attrs(obj):
         LOGGER.debug('Deactivating obj: %s', name)
         _r.patch_obj(obj, None)
         Changes.del_backref(obj, BackRef(parent, obj, name, source))
@@ -410,6 +482,13 @@ def deaktiv8(
 
 
 class Reaktome:
+    # Empty, so slotted subclasses (e.g. @dataclass(slots=True)) stay
+    # without a __dict__.
+    __slots__ = ()
+
+    # Set to True to hold native containers (see reaktiv8).
+    __reaktome_native__ = False
+
     def __init__(self, *args: Any, **kwargs: Any) -> None:
         super().__init__(*args, **kwargs)
         self.__reaktiv8__()
@@ -25,6 +25,8 @@ setup(
                 "src/set.c",
                 "src/obj.c",
                 "src/activation.c",
+                "src/ptr_table.c",
+                "src/stats.c",
             ],
             include_dirs=["src"],  # <— tells gcc where to find reaktome.h
             library_dirs=[python_libdir] if python_libdir else [],
@@ -1,28 +1,690 @@
 /* src/activation.c
    Side-table helpers for Reaktome.
-   Keyed by PyLong_FromVoidPtr((void*)obj) to avoid depending on the object's
-   hashability.  No module init here; this file provides pure C helpers.
+   Keyed directly on the raw PyObject* (identity) so lookups never allocate
+   and never depend on the object's hashability.  No module init here; this
+   file provides pure C helpers.
 */
 
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
+#include <stdint.h>
+#include <string.h>
 #include "activation.h"
+#include "ptr_table.h"
+#include "stats.h"
 
-/* activation_map: dict mapping PyLong(id(obj)) -> dict(hookname->callable)
-   Keys are PyLong objects created from the pointer value. */
-static PyObject *activation_map = NULL;
+/* ---------- per-type state ----------
+   type_states: PyTypeObject* -> reaktome_type_state*. `active` counts the
+   side-table entries that make instances of the type observable, so
+   trampolines can skip the instance probe entirely for types with nothing
+   activated. The state also remembers the deallocation slots replaced for
+   eviction and, for install keys, the patchers' uninstall callbacks plus
+   the number of entries holding them; it is dropped once none of that is in use. */
+
+/* Patchers sharing one install key (list and obj on a list subclass) */
+#define MAX_UNINSTALLS 4
+
+typedef struct {
+    Py_ssize_t active;
+    destructor orig_dealloc;   /* static types: replaced tp_dealloc */
+    destructor orig_finalize;  /* heap types: replaced tp_finalize (may be NULL) */
+    int evicting;              /* deallocation slot replaced */
+    Py_ssize_t holders;        /* entries keeping the install alive */
+    reaktome_uninstall_fn uninstall[MAX_UNINSTALLS];  /* one per patcher */
+    int n_uninstall;           /* trampolines installed when nonzero */
+    Py_ssize_t inline_offset;  /* native containers: embedded entry, or 0 */
+} reaktome_type_state;
+
+static ptr_table type_states;
+
+static inline reaktome_type_state *
+type_state_find(PyTypeObject *tp)
+{
+    ptr_entry *e = ptr_table_find(&type_states, tp);
+    return e ? (reaktome_type_state *)e->value : NULL;
+}
+
+/* Return the state for tp, creating it if needed (NULL + exception on error). */
+static reaktome_type_state *
+type_state_ensure(PyTypeObject *tp)
+{
+    reaktome_type_state *st = type_state_find(tp);
+    if (st) return st;
+
+    st = PyMem_Calloc(1, sizeof(reaktome_type_state));
+    if (!st) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if (!ptr_table_insert(&type_states, tp, st)) {
+        PyMem_Free(st);
+        return NULL;
+    }
+    return st;
+}
+
+static void
+type_state_release(PyTypeObject *tp, reaktome_type_state *st)
+{
+    if (st->active > 0 || st->evicting || st->holders > 0 || st->n_uninstall) return;
+    ptr_table_pop(&type_states, tp);
+    PyMem_Free(st);
+}
+
+static int
+type_state_incref(PyTypeObject *tp)
+{
+    reaktome_type_state *st = type_state_ensure(tp);
+    if (!st) return -1;
+    st->active++;
+    return 0;
+}
+
+static void
+type_state_decref(PyTypeObject *tp)
+{
+    reaktome_type_state *st = type_state_find(tp);
+    if (!st) return;
+    st->active--;
+    type_state_release(tp, st);
+}
+
+/* ---------- compiled hooks ---------- */
+
+/* Indexed by reaktome_hook */
+static const char *const hook_names[REAKTOME_HOOK_COUNT] = {
+    "__reaktome_setitem__",
+    "__reaktome_delitem__",
+    "__reaktome_setslice__",
+    "__reaktome_reorder__",
+    "__reaktome_repeat__",
+    "__reaktome_update__",
+    "__reaktome_clear__",
+    "__reaktome_delta__",
+    "__reaktome_additem__",
+    "__reaktome_discarditem__",
+    "__reaktome_setattr__",
+    "__reaktome_delattr__",
+    "__setattr__",
+    "__delattr__",
+};
+
+const char *
+activation_hook_name(reaktome_hook hook)
+{
+    return hook_names[hook];
+}
+
+unsigned int
+activation_hook_mask(PyObject *dunders)
+{
+    if (!dunders || !PyDict_Check(dunders)) return 0;
+    unsigned int mask = 0;
+    for (int i = 0; i < REAKTOME_HOOK_COUNT; i++) {
+        PyObject *callable = PyDict_GetItemString(dunders, hook_names[i]); /* borrowed */
+        if (callable && callable != Py_None) mask |= REAKTOME_HOOK_BIT(i);
+    }
+    return mask;
+}
+
+static int
+hook_id_from_name(const char *name)
+{
+    for (int i = 0; i < REAKTOME_HOOK_COUNT; i++) {
+        if (strcmp(hook_names[i], name) == 0) return i;
+    }
+    return -1;
+}
 
-/* Ensure activation_map exists. Return 0 on success, -1 on error (exception set). */
 static int
-ensure_activation_map(void)
+compile_noop(PyObject *dunders, reaktome_noop *out)
 {
-    if (activation_map)
+    *out = REAKTOME_NOOP_REPORT;
+    PyObject *mode = PyDict_GetItemString(dunders, "__reaktome_skip_noop__"); /* borrowed */
+    if (!mode || mode == Py_None || mode == Py_False) return 0;
+    if (mode == Py_True) {
+        *out = REAKTOME_NOOP_IDENTITY;
         return 0;
-    activation_map = PyDict_New();
-    if (!activation_map) return -1;
+    }
+    if (PyUnicode_Check(mode)) {
+        if (PyUnicode_CompareWithASCIIString(mode, "identity") == 0) {
+            *out = REAKTOME_NOOP_IDENTITY;
+            return 0;
+        }
+        if (PyUnicode_CompareWithASCIIString(mode, "equality") == 0) {
+            *out = REAKTOME_NOOP_EQUALITY;
+            return 0;
+        }
+    }
+    PyErr_Format(PyExc_ValueError,
+                 "__reaktome_skip_noop__ must be a bool, \"identity\" or "
+                 "\"equality\", not %R", mode);
+    return -1;
+}
+
+/* Compile "__reaktome_filter__". Iterables other than str and frozenset
+   are frozen and stored back, so the compiled set stays owned by the
+   dunders dict like the hooks. */
+static int
+compile_filter(PyObject *dunders, reaktome_filter *out, PyObject **arg)
+{
+    *out = REAKTOME_FILTER_NONE;
+    *arg = NULL;
+    PyObject *spec = PyDict_GetItemString(dunders, "__reaktome_filter__"); /* borrowed */
+    if (!spec || spec == Py_None) return 0;
+    if (PyUnicode_Check(spec)) {
+        *out = REAKTOME_FILTER_PREFIX;
+        *arg = spec;
+        return 0;
+    }
+    if (!PyFrozenSet_CheckExact(spec)) {
+        PyObject *frozen = PyFrozenSet_New(spec);
+        if (!frozen) {
+            if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+                PyErr_Format(PyExc_TypeError,
+                             "__reaktome_filter__ must be a str prefix or an "
+                             "iterable of keys, not %R", spec);
+            }
+            return -1;
+        }
+        int rc = PyDict_SetItemString(dunders, "__reaktome_filter__", frozen);
+        Py_DECREF(frozen); /* dunders owns it */
+        if (rc < 0) return -1;
+        spec = frozen;
+    }
+    *out = REAKTOME_FILTER_ALLOW;
+    *arg = spec;
+    return 0;
+}
+
+int
+activation_filter_matches(const reaktome_hooks *h, PyObject *key)
+{
+    if (h->filter == REAKTOME_FILTER_PREFIX) {
+        if (!PyUnicode_Check(key)) return 1;
+        Py_ssize_t rc = PyUnicode_Tailmatch(key, h->filter_arg, 0, PY_SSIZE_T_MAX, -1);
+        if (rc < 0) PyErr_Clear();
+        return rc != 1;
+    }
+    if (h->filter == REAKTOME_FILTER_ALLOW) {
+        int rc = PySet_Contains(h->filter_arg, key);
+        if (rc < 0) PyErr_Clear();
+        return rc != 0;
+    }
+    return 1;
+}
+
+/* (Re)build the per-slot view from h->dunders. Called after every change
+   to the dict, so the borrowed slots always match its contents. */
+static int
+hooks_compile(reaktome_hooks *h)
+{
+    for (int i = 0; i < REAKTOME_HOOK_COUNT; i++) {
+        PyObject *callable = PyDict_GetItemString(h->dunders, hook_names[i]); /* borrowed */
+        h->hooks[i] = (callable == Py_None) ? NULL : callable;
+    }
+    if (compile_noop(h->dunders, &h->skip_noop) < 0) return -1;
+    if (compile_filter(h->dunders, &h->filter, &h->filter_arg) < 0) return -1;
+    return 0;
+}
+
+/* Swap in new settings for a live entry: compile `dunders` (stolen) on
+   the side and replace h only if that succeeds, so a bad setting leaves
+   the previous dict and everything borrowed from it in place. */
+static int
+hooks_replace(reaktome_hooks *h, PyObject *dunders)
+{
+    reaktome_hooks next = {.dunders = dunders};
+    if (hooks_compile(&next) < 0) {
+        Py_DECREF(dunders);
+        return -1;
+    }
+    PyObject *prev = h->dunders;
+    *h = next;
+    Py_DECREF(prev);
+    return 0;
+}
+
+/* ---------- activation table ----------
+   activations: object pointer -> activation_entry*. The entry owns the
+   compiled hooks and remembers the type it was counted against, so a later
+   __class__ assignment cannot unbalance the counters, plus the install it
+   holds (see "installs" below).
+
+   Native containers embed their entry instead (see "inline entries"):
+   inline_active lists the observed ones, only so they can be found for
+   deactivation and unpatch_all; lookups never probe it. */
+
+typedef reaktome_entry activation_entry;
+
+static void install_release(PyTypeObject *install);
+
+static ptr_table activations;
+static ptr_table inline_active;
+
+/* Number of live activations; zero means every trampoline can fall through. */
+Py_ssize_t activation_live = 0;
+
+static inline void
+live_update(void)
+{
+    activation_live = activations.used + inline_active.used;
+}
+
+/* Fill in entry for obj and count it against its type. Takes a NEW
+   reference to hooks (stolen, also on failure, which leaves the entry
+   inactive). */
+static int
+entry_open(activation_entry *entry, PyObject *obj, PyObject *hooks)
+{
+    entry->hooks.dunders = hooks;
+    entry->type = Py_TYPE(obj);
+    entry->install = NULL;
+
+    if (hooks_compile(&entry->hooks) < 0) goto fail;
+
+    if (type_state_incref(entry->type) < 0) goto fail;
+    /* type-level hooks make every instance of that type observable */
+    if (PyType_Check(obj) && type_state_incref((PyTypeObject *)obj) < 0) {
+        type_state_decref(entry->type);
+        goto fail;
+    }
+    return 0;
+
+fail:
+    entry->hooks.dunders = NULL;
+    Py_DECREF(hooks);
+    return -1;
+}
+
+static void
+entry_uncount(activation_entry *entry, PyObject *obj)
+{
+    if (PyType_Check(obj)) type_state_decref((PyTypeObject *)obj);
+    type_state_decref(entry->type);
+}
+
+/* Register a new entry for obj. Takes a NEW reference to hooks (stolen,
+   also on failure). */
+static int
+activation_insert(PyObject *obj, PyObject *hooks)
+{
+    activation_entry *entry = PyMem_Malloc(sizeof(activation_entry));
+    if (!entry) {
+        Py_DECREF(hooks);
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (entry_open(entry, obj, hooks) < 0) {
+        PyMem_Free(entry);
+        return -1;
+    }
+    if (!ptr_table_insert(&activations, obj, entry)) {
+        entry_uncount(entry, obj);
+        Py_DECREF(hooks);
+        PyMem_Free(entry);
+        return -1;
+    }
+    live_update();
     return 0;
 }
 
+/* Drop the entry for obj, if any. The hooks dict is released only after the
+   tables are consistent, since its deallocation may run arbitrary code;
+   the install goes last, as it may be torn down with it. */
+static void
+activation_remove(PyObject *obj)
+{
+    activation_entry *entry = ptr_table_pop(&activations, obj);
+    int embedded = 0;
+    if (!entry && inline_active.used) {
+        entry = ptr_table_pop(&inline_active, obj);
+        embedded = 1;
+    }
+    if (!entry) return;
+    live_update();
+    entry_uncount(entry, obj);
+
+    PyObject *hooks = entry->hooks.dunders;
+    PyTypeObject *install = entry->install;
+    if (embedded) {
+        entry->hooks.dunders = NULL;
+        entry->install = NULL;
+    } else {
+        PyMem_Free(entry);
+    }
+    Py_DECREF(hooks);
+    if (install) install_release(install);
+}
+
+/* The active entry for obj itself (no type-level fallback), or NULL. */
+static activation_entry *
+entry_of(PyObject *obj)
+{
+    ptr_entry *e = ptr_table_find(&activations, obj);
+    if (!e && inline_active.used) e = ptr_table_find(&inline_active, obj);
+    return e ? (activation_entry *)e->value : NULL;
+}
+
+/* Return the entry for obj, falling back to type(obj); NULL if none. */
+static inline activation_entry *
+activation_find(PyObject *obj)
+{
+    ptr_entry *e = ptr_table_find(&activations, obj);
+    if (!e) e = ptr_table_find(&activations, Py_TYPE(obj));
+    return e ? (activation_entry *)e->value : NULL;
+}
+
+/* ---------- inline entries ----------
+   Native containers (ReaktomeList & co.) embed their entry at a fixed
+   offset. While one of them is observed, its type's state records the
+   offset, so the per-type probe every trampoline already makes also yields
+   the hooks: no side-table lookup. */
+
+#define MAX_INLINE_TYPES 4
+
+static struct {
+    PyTypeObject *type;
+    Py_ssize_t offset;
+} inline_types[MAX_INLINE_TYPES];
+static int n_inline_types = 0;
+
+int
+activation_register_inline(PyTypeObject *tp, Py_ssize_t offset)
+{
+    if (n_inline_types == MAX_INLINE_TYPES) {
+        PyErr_SetString(PyExc_RuntimeError, "too many native container types");
+        return -1;
+    }
+    inline_types[n_inline_types].type = tp;
+    inline_types[n_inline_types].offset = offset;
+    n_inline_types++;
+    return 0;
+}
+
+/* Offset of the entry obj embeds, or 0 if it is not a native container. */
+static Py_ssize_t
+inline_offset(PyObject *obj)
+{
+    for (int i = 0; i < n_inline_types; i++) {
+        if (PyObject_TypeCheck(obj, inline_types[i].type))
+            return inline_types[i].offset;
+    }
+    return 0;
+}
+
+int
+activation_is_inline(PyObject *obj)
+{
+    return inline_offset(obj) != 0;
+}
+
+/* The embedded hooks of obj, whose type state is st, if they are active. */
+static inline const reaktome_hooks *
+inline_hooks(const reaktome_type_state *st, PyObject *obj)
+{
+    if (!st->inline_offset) return NULL;
+    activation_entry *entry = (activation_entry *)((char *)obj + st->inline_offset);
+    return entry->hooks.dunders ? &entry->hooks : NULL;
+}
+
+/* Activate the entry embedded at offset in obj. Takes a NEW reference to
+   hooks (stolen, also on failure). */
+static int
+inline_insert(PyObject *obj, Py_ssize_t offset, PyObject *hooks)
+{
+    activation_entry *entry = (activation_entry *)((char *)obj + offset);
+    if (entry_open(entry, obj, hooks) < 0) return -1;
+    type_state_find(entry->type)->inline_offset = offset;
+    if (!ptr_table_insert(&inline_active, obj, entry)) {
+        entry_uncount(entry, obj);
+        Py_CLEAR(entry->hooks.dunders);
+        return -1;
+    }
+    live_update();
+    return 0;
+}
+
+/* ---------- eviction on deallocation ----------
+   Entries are keyed by address, so they must go before the memory can be
+   reused. Static builtin types (list/dict/set) get a tp_dealloc wrapper;
+   subclass instances reach it too, because subtype_dealloc ends by calling
+   the nearest static base's tp_dealloc. Heap types cannot be wrapped that
+   way (subtype_dealloc would re-enter itself), so they get a tp_finalize
+   wrapper instead, which subtype_dealloc and the GC call exactly once. */
+
+static void evicting_dealloc(PyObject *self);
+static void evicting_finalize(PyObject *self);
+
+/* The slot our wrapper stands in for, for an object of type tp: the saved
+   original of the nearest wrapped type, else the first unwrapped slot above
+   a type that inherited the wrapper after its owner was uninstalled. For
+   tp_dealloc the walk first climbs to the type whose slot called us,
+   skipping heap types (subtype_dealloc) and static subclasses that chain
+   to their base explicitly (e.g. OrderedDict). */
+static destructor
+original_dealloc(PyTypeObject *tp)
+{
+    for (; tp; tp = tp->tp_base) {
+        if (tp->tp_flags & Py_TPFLAGS_HEAPTYPE) continue;
+        reaktome_type_state *st = type_state_find(tp);
+        if (st && st->evicting) return st->orig_dealloc;
+        if (tp->tp_dealloc == evicting_dealloc) break;
+    }
+    for (; tp; tp = tp->tp_base) {
+        reaktome_type_state *st = type_state_find(tp);
+        if (st && st->evicting) return st->orig_dealloc;
+        if (tp->tp_dealloc != evicting_dealloc) return tp->tp_dealloc;
+    }
+    return NULL;
+}
+
+static destructor
+original_finalize(PyTypeObject *tp)
+{
+    for (; tp; tp = tp->tp_base) {
+        reaktome_type_state *st = type_state_find(tp);
+        if (st && st->evicting && (tp->tp_flags & Py_TPFLAGS_HEAPTYPE))
+            return st->orig_finalize;
+        if (tp->tp_finalize != evicting_finalize) return tp->tp_finalize;
+    }
+    return NULL;
+}
+
+static void
+evicting_dealloc(PyObject *self)
+{
+    /* resolved before the removal: dropping the last holder uninstalls the
+       wrapper and frees the state that remembers the original */
+    destructor dealloc = original_dealloc(Py_TYPE(self));
+    assert(dealloc);
+    if (activation_live) activation_remove(self);
+    dealloc(self);
+}
+
+static void
+evicting_finalize(PyObject *self)
+{
+    destructor finalize = original_finalize(Py_TYPE(self));
+    if (activation_live) activation_remove(self);
+    if (finalize) finalize(self);
+}
+
+int
+activation_evict_on_dealloc(PyTypeObject *tp)
+{
+    reaktome_type_state *st = type_state_ensure(tp);
+    if (!st) return -1;
+    if (st->evicting) return 0;
+
+    if (tp->tp_flags & Py_TPFLAGS_HEAPTYPE) {
+        st->orig_finalize = tp->tp_finalize == evicting_finalize
+            ? original_finalize(tp) : tp->tp_finalize;
+        tp->tp_finalize = evicting_finalize;
+    } else {
+        st->orig_dealloc = tp->tp_dealloc == evicting_dealloc
+            ? original_dealloc(tp) : tp->tp_dealloc;
+        tp->tp_dealloc = evicting_dealloc;
+    }
+    st->evicting = 1;
+    return 0;
+}
+
+/* Put back the deallocation slot replaced by activation_evict_on_dealloc. */
+static void
+evict_restore(PyTypeObject *tp, reaktome_type_state *st)
+{
+    if (!st->evicting) return;
+    if (tp->tp_flags & Py_TPFLAGS_HEAPTYPE) {
+        if (tp->tp_finalize == evicting_finalize) tp->tp_finalize = st->orig_finalize;
+    } else {
+        if (tp->tp_dealloc == evicting_dealloc) tp->tp_dealloc = st->orig_dealloc;
+    }
+    st->evicting = 0;
+}
+
+/* ---------- installs ----------
+   A patcher that installs trampolines registers an uninstall callback
+   under an install key (a type). Entries created through
+   activation_merge_installed hold the key; when the last holder goes away
+   the callback restores the patcher's slots and methods, and the key's
+   eviction wrapper is removed too, so the type runs at full speed again.
+
+   Static builtin types (list, dict, set) are the exception: their
+   installs stay until unpatch_all(). Every uninstall and reinstall calls
+   PyType_Modified, and a static type's new version tag comes from a small
+   global pool (2^16 on 3.12). A loop that observes one list at a time
+   would run it dry, after which 3.12 can call stale cached method
+   descriptors. With nothing observed the trampolines fall through. */
+
+#if PY_VERSION_HEX >= 0x030D0000
+#define reaktome_is_finalizing() Py_IsFinalizing()
+#else
+#define reaktome_is_finalizing() _Py_IsFinalizing()
+#endif
+
+static inline int
+install_persists(PyTypeObject *install)
+{
+    return !(install->tp_flags & Py_TPFLAGS_HEAPTYPE);
+}
+
+static void
+install_teardown(PyTypeObject *install, reaktome_type_state *st)
+{
+    reaktome_uninstall_fn uninstall[MAX_UNINSTALLS];
+    int n = st->n_uninstall;
+    memcpy(uninstall, st->uninstall, sizeof(uninstall));
+    st->n_uninstall = 0;
+
+    /* nothing to gain, and type dicts may already be gone */
+    if (reaktome_is_finalizing()) return;
+
+    /* may run from a deallocator while an exception is in flight */
+    PyObject *exc = PyErr_GetRaisedException();
+    for (int i = 0; i < n; i++) {
+        uninstall[i](install);
+        if (PyErr_Occurred()) PyErr_WriteUnraisable((PyObject *)install);
+    }
+    PyErr_SetRaisedException(exc);
+
+    st = type_state_find(install);
+    if (!st) return;
+    evict_restore(install, st);
+    PyType_Modified(install);
+    type_state_release(install, st);
+}
+
+static void
+install_release(PyTypeObject *install)
+{
+    reaktome_type_state *st = type_state_find(install);
+    if (!st) return;
+    if (--st->holders == 0 && st->n_uninstall && !install_persists(install)) {
+        install_teardown(install, st);
+        return;
+    }
+    type_state_release(install, st);
+}
+
+int
+activation_install(PyTypeObject *install, reaktome_uninstall_fn uninstall)
+{
+    reaktome_type_state *st = type_state_ensure(install);
+    if (!st) return -1;
+    if (activation_installed(install, uninstall)) return 0;
+    if (st->n_uninstall == MAX_UNINSTALLS) {
+        PyErr_SetString(PyExc_SystemError, "activation_install: too many patchers");
+        return -1;
+    }
+    st->uninstall[st->n_uninstall++] = uninstall;
+    return 0;
+}
+
+int
+activation_installed(PyTypeObject *install, reaktome_uninstall_fn uninstall)
+{
+    reaktome_type_state *st = type_state_find(install);
+    if (!st) return 0;
+    for (int i = 0; i < st->n_uninstall; i++)
+        if (st->uninstall[i] == uninstall) return 1;
+    return 0;
+}
+
+int
+activation_merge_installed(PyObject *obj, PyObject *dunders, PyTypeObject *install)
+{
+    if (activation_merge(obj, dunders) < 0) return -1;
+
+    if (dunders == Py_None) {
+        /* the removal released any hold; also catch installs nobody held */
+        reaktome_type_state *st = type_state_find(install);
+        if (st && st->n_uninstall && st->holders == 0 && !install_persists(install))
+            install_teardown(install, st);
+        return 0;
+    }
+
+    activation_entry *entry = entry_of(obj);
+    if (entry->install) return 0;
+    reaktome_type_state *st = type_state_ensure(install);
+    if (!st) return -1;
+    st->holders++;
+    entry->install = install;
+    return 0;
+}
+
+int
+activation_unpatch_all(void)
+{
+    Py_ssize_t n;
+    const void **keys = ptr_table_keys(&activations, &n);
+    if (!keys) return -1;
+    for (Py_ssize_t i = 0; i < n; i++) activation_remove((PyObject *)keys[i]);
+    PyMem_Free(keys);
+
+    keys = ptr_table_keys(&inline_active, &n);
+    if (!keys) return -1;
+    for (Py_ssize_t i = 0; i < n; i++) activation_remove((PyObject *)keys[i]);
+    PyMem_Free(keys);
+
+    /* installs that never had a holder */
+    keys = ptr_table_keys(&type_states, &n);
+    if (!keys) return -1;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyTypeObject *tp = (PyTypeObject *)keys[i];
+        reaktome_type_state *st = type_state_find(tp);
+        if (st && st->n_uninstall) install_teardown(tp, st);
+    }
+    PyMem_Free(keys);
+    return 0;
+}
+
+Py_ssize_t
+activation_size(void)
+{
+    return activations.used;
+}
+
 /* activation_merge:
    - obj must be a non-NULL PyObject* (either an instance or a type cast to PyObject*).
    - dunders: dict to merge, or Py_None to clear the entry for obj.
@@ -35,80 +697,82 @@ activation_merge(PyObject *obj, PyObject *dunders)
         return -1;
     }
 
-    if (ensure_activation_map() < 0) return -1;
-
-    PyObject *key = PyLong_FromVoidPtr((void *)obj);
-    if (!key) return -1;
-
     if (dunders == Py_None) {
         /* Clear the entry (ignore if absent). */
-        if (PyDict_DelItem(activation_map, key) < 0) {
-            PyErr_Clear();
-        }
-        Py_DECREF(key);
+        activation_remove(obj);
         return 0;
     }
 
     if (!PyDict_Check(dunders)) {
-        Py_DECREF(key);
         PyErr_SetString(PyExc_TypeError, "activation_merge: dunders must be a dict or None");
         return -1;
     }
 
     /* If an entry already exists, update (merge) into it; otherwise insert a copy. */
-    PyObject *existing = PyDict_GetItem(activation_map, key); /* borrowed */
-    if (existing) {
-        /* existing is a dict; update it in-place */
-        if (PyDict_Update(existing, dunders) < 0) {
-            Py_DECREF(key);
+    activation_entry *entry = entry_of(obj);
+    if (entry) {
+        /* merge into a copy of the existing dict, then swap it in */
+        PyObject *merged = PyDict_Copy(entry->hooks.dunders); /* newref */
+        if (!merged) return -1;
+        if (PyDict_Update(merged, dunders) < 0) {
+            Py_DECREF(merged);
             return -1;
         }
-        Py_DECREF(key);
-        return 0;
-    } else {
-        PyObject *copy = PyDict_Copy(dunders); /* newref */
-        if (!copy) { Py_DECREF(key); return -1; }
-        if (PyDict_SetItem(activation_map, key, copy) < 0) {
-            Py_DECREF(copy);
-            Py_DECREF(key);
-            return -1;
-        }
-        Py_DECREF(copy);
-        Py_DECREF(key);
-        return 0;
+        return hooks_replace(&entry->hooks, merged);
     }
+
+    PyObject *copy = PyDict_Copy(dunders); /* newref */
+    if (!copy) return -1;
+    Py_ssize_t offset = PyType_Check(obj) ? 0 : inline_offset(obj);
+    if (offset) return inline_insert(obj, offset, copy);
+    return activation_insert(obj, copy);
 }
 
 /* Return NEW reference to hooks dict for obj (instance), or NULL if none.
-   Try instance key first, then fall back to type(obj). No exception set if none. */
+   Try instance key first, then fall back to type(obj). No exception set if none.
+   Never allocates. */
 PyObject *
 activation_get_hooks(PyObject *obj)
 {
-    if (!obj) return NULL;
-    if (!activation_map) return NULL;
+    const reaktome_hooks *h = activation_lookup(obj);
+    return h ? Py_NewRef(h->dunders) : NULL;
+}
 
-    /* instance key */
-    PyObject *key = PyLong_FromVoidPtr((void *)obj);
-    if (!key) return NULL;
+const reaktome_hooks *
+activation_lookup(PyObject *obj)
+{
+    if (!obj || !activation_live) return NULL;
 
-    PyObject *existing = PyDict_GetItem(activation_map, key); /* borrowed */
-    if (existing) {
-        Py_INCREF(existing);
-        Py_DECREF(key);
-        return existing; /* newref */
+    if (inline_active.used) {
+        reaktome_type_state *st = type_state_find(Py_TYPE(obj));
+        const reaktome_hooks *h = st ? inline_hooks(st, obj) : NULL;
+        if (h) return h;
     }
-    Py_DECREF(key);
+    activation_entry *entry = activation_find(obj);
+    return entry ? &entry->hooks : NULL;
+}
 
-    /* try type-level hooks */
-    PyObject *type_key = PyLong_FromVoidPtr((void *)Py_TYPE(obj));
-    if (!type_key) return NULL;
+/* Per-type counter first, then the embedded entry of a native container,
+   then the instance (or type-level) entry. */
+const reaktome_hooks *
+activation_lookup_active(PyObject *obj)
+{
+    if (!activation_live) return NULL;
+    ptr_entry *e = ptr_table_find(&type_states, Py_TYPE(obj));
+    if (!e) return NULL;
+    reaktome_type_state *st = e->value;
+    if (st->active <= 0) return NULL;
 
-    PyObject *type_existing = PyDict_GetItem(activation_map, type_key); /* borrowed */
-    if (!type_existing) { Py_DECREF(type_key); return NULL; }
+    const reaktome_hooks *h = inline_hooks(st, obj);
+    if (h) return h;
+    activation_entry *entry = activation_find(obj);
+    return entry ? &entry->hooks : NULL;
+}
 
-    Py_INCREF(type_existing);
-    Py_DECREF(type_key);
-    return type_existing;
+int
+activation_has_hooks(PyObject *obj)
+{
+    return activation_lookup_active(obj) != NULL;
 }
 
 /* Treat the type pointer as a PyObject* and forward to activation_merge. */
@@ -147,25 +811,155 @@ activation_set_type(PyTypeObject *type, PyObject *dunders)
         return -1;
     }
 
-    if (ensure_activation_map() < 0) return -1;
+    PyObject *copy = PyDict_Copy(dunders);
+    if (!copy) return -1;
 
-    PyObject *key = PyLong_FromVoidPtr((void *)type);
-    if (!key) return -1;
+    ptr_entry *e = ptr_table_find(&activations, type);
+    if (!e) return activation_insert((PyObject *)type, copy);
 
-    PyObject *copy = PyDict_Copy(dunders);
-    if (!copy) { Py_DECREF(key); return -1; }
+    return hooks_replace(&((activation_entry *)e->value)->hooks, copy);
+}
+
+/* Invoke callable(self, key, old, new); missing args are passed as None.
+   Arguments go through vectorcall from a stack array: no args tuple and no
+   incref/decref of the arguments, which the caller keeps alive for the
+   duration of the call. Only the callable is held, since the hook may
+   deactivate self and drop the dict that owns it. */
+static int
+call_hook_object(PyObject *callable, PyObject *self,
+                 PyObject *key, PyObject *old, PyObject *newv)
+{
+    /* slot 0 is scratch space for PY_VECTORCALL_ARGUMENTS_OFFSET, so bound
+       methods can prepend their self without copying */
+    PyObject *stack[5] = {
+        NULL,
+        self,
+        key ? key : Py_None,
+        old ? old : Py_None,
+        newv ? newv : Py_None,
+    };
 
-    if (PyDict_SetItem(activation_map, key, copy) < 0) {
-        Py_DECREF(copy);
-        Py_DECREF(key);
+    Py_INCREF(callable);
+    /* Always call as func(self, key, old, new) */
+    PyObject *res = PyObject_Vectorcall(callable, stack + 1,
+                                        4 | PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);
+    Py_DECREF(callable);
+
+    if (!res) {
+        /* propagate Python exception */
         return -1;
     }
-    Py_DECREF(copy);
-    Py_DECREF(key);
+    Py_DECREF(res);
     return 0;
 }
 
+/* call_hook_object for a compiled hook, timed while stats are enabled. */
+static inline int
+dispatch_hook(PyObject *callable, PyObject *self, reaktome_hook hook,
+              PyObject *key, PyObject *old, PyObject *newv)
+{
+    if (!reaktome_stats_enabled)
+        return call_hook_object(callable, self, key, old, newv);
+
+    int64_t t0 = reaktome_stats_clock();
+    int rc = call_hook_object(callable, self, key, old, newv);
+    reaktome_stats_record_hook(self, hook, t0, rc < 0);
+    return rc;
+}
+
+/* Call hook `hook` if present for this object.
+   Returns 0 if no hook present or on successful call; -1 on exception
+   (Python exception is left set). */
+int
+reaktome_call_hook(PyObject *self,
+                   reaktome_hook hook,
+                   PyObject *key,
+                   PyObject *old,
+                   PyObject *newv)
+{
+    const reaktome_hooks *h = activation_lookup(self);
+    if (!h || !h->hooks[hook]) {
+        /* no hooks -> not an error */
+        return 0;
+    }
+    if (!activation_filter_passes(h, key)) return 0;
+    return dispatch_hook(h->hooks[hook], self, hook, key, old, newv);
+}
+
+int
+reaktome_call_hook_object(PyObject *callable,
+                          PyObject *self,
+                          reaktome_hook hook,
+                          PyObject *key,
+                          PyObject *old,
+                          PyObject *newv)
+{
+    return dispatch_hook(callable, self, hook, key, old, newv);
+}
+
+int
+activation_is_noop(PyObject *obj, PyObject *old, PyObject *newv)
+{
+    if (!old || !newv) return 0;
+    return activation_noop_matches(activation_noop_mode(obj), old, newv);
+}
+
+int
+activation_noop_matches(reaktome_noop mode, PyObject *old, PyObject *newv)
+{
+    if (!old || !newv || mode == REAKTOME_NOOP_REPORT) return 0;
+    if (old == newv) return 1;
+    if (mode != REAKTOME_NOOP_EQUALITY) return 0;
+
+    PyObject *exc = PyErr_GetRaisedException();
+    int eq = PyObject_RichCompareBool(old, newv, Py_EQ);
+    if (eq < 0) PyErr_Clear();
+    PyErr_SetRaisedException(exc);
+    return eq > 0;
+}
+
+/* ---------- index keys ----------
+   List hooks receive their index as an int. CPython shares ints up to 256;
+   indices below REAKTOME_INDEX_KEYS are kept here once a hook has needed
+   them, so events on lists of common sizes do not allocate a key. */
+
+#define REAKTOME_INDEX_KEYS 1024
+
+static PyObject *index_keys[REAKTOME_INDEX_KEYS];
+
+static PyObject *
+index_key(Py_ssize_t index) /* newref */
+{
+    if (index < 0 || index >= REAKTOME_INDEX_KEYS)
+        return PyLong_FromSsize_t(index);
+    if (!index_keys[index]) {
+        index_keys[index] = PyLong_FromSsize_t(index);
+        if (!index_keys[index]) return NULL;
+    }
+    return Py_NewRef(index_keys[index]);
+}
+
+int
+reaktome_call_hook_index(PyObject *self,
+                         reaktome_hook hook,
+                         Py_ssize_t index,
+                         PyObject *old,
+                         PyObject *newv)
+{
+    const reaktome_hooks *h = activation_lookup(self);
+    if (!h || !h->hooks[hook]) return 0;
+
+    PyObject *callable = h->hooks[hook];
+    PyObject *key = index_key(index);
+    if (!key) return -1;
+    int rc = dispatch_hook(callable, self, hook, key, old, newv);
+    Py_DECREF(key);
+    return rc;
+}
+
 /* Call dunder if present for this object.
+   Known hook names go through the compiled slots; anything else is looked
+   up in the merged dunders dict.
    Returns 0 if no hook present or on successful call; -1 on exception
    (Python exception is left set). */
 int
@@ -180,34 +974,13 @@ reaktome_call_dunder(PyObject *self,
         return -1;
     }
 
-    PyObject *hooks = activation_get_hooks(self); /* newref or NULL */
-    if (!hooks) {
-        /* no hooks -> not an error */
-        return 0;
-    }
-
-    PyObject *callable = PyDict_GetItemString(hooks, name); /* borrowed */
-    if (!callable) {
-        Py_DECREF(hooks);
-        return 0;
-    }
+    int id = hook_id_from_name(name);
+    if (id >= 0) return reaktome_call_hook(self, (reaktome_hook)id, key, old, newv);
 
-    /* Normalize missing args to None */
-    PyObject *k = key ? key : Py_None;
-    PyObject *o = old ? old : Py_None;
-    PyObject *n = newv ? newv : Py_None;
-    Py_INCREF(k); Py_INCREF(o); Py_INCREF(n);
+    const reaktome_hooks *h = activation_lookup(self);
+    if (!h) return 0;
 
-    /* Always call as func(self, key, old, new) */
-    PyObject *res = PyObject_CallFunctionObjArgs(callable, self, k, o, n, NULL);
-
-    Py_DECREF(k); Py_DECREF(o); Py_DECREF(n);
-    Py_DECREF(hooks);
-
-    if (!res) {
-        /* propagate Python exception */
-        return -1;
-    }
-    Py_DECREF(res);
-    return 0;
+    PyObject *callable = PyDict_GetItemString(h->dunders, name); /* borrowed */
+    if (!callable) return 0;
+    return call_hook_object(callable, self, key, old, newv);
 }
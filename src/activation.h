@@ -8,6 +8,76 @@
 extern "C" {
 #endif
 
+/* Hooks known to the trampolines. activation_merge compiles the dunders
+   dict into one slot per id so hot paths index by enum instead of probing
+   the dict by name. */
+typedef enum {
+    REAKTOME_HOOK_SETITEM,      /* "__reaktome_setitem__" */
+    REAKTOME_HOOK_DELITEM,      /* "__reaktome_delitem__" */
+    REAKTOME_HOOK_SETSLICE,     /* "__reaktome_setslice__" (bulk, lists) */
+    REAKTOME_HOOK_REORDER,      /* "__reaktome_reorder__" (sort/reverse, lists) */
+    REAKTOME_HOOK_REPEAT,       /* "__reaktome_repeat__" (*=, lists) */
+    REAKTOME_HOOK_UPDATE,       /* "__reaktome_update__" (bulk, dicts) */
+    REAKTOME_HOOK_CLEAR,        /* "__reaktome_clear__" (bulk, lists, dicts, sets) */
+    REAKTOME_HOOK_DELTA,        /* "__reaktome_delta__" (bulk, sets) */
+    REAKTOME_HOOK_ADDITEM,      /* "__reaktome_additem__" */
+    REAKTOME_HOOK_DISCARDITEM,  /* "__reaktome_discarditem__" */
+    REAKTOME_HOOK_SETATTR,      /* "__reaktome_setattr__" */
+    REAKTOME_HOOK_DELATTR,      /* "__reaktome_delattr__" */
+    REAKTOME_HOOK_PRE_SETATTR,  /* "__setattr__" (advisory, before mutation) */
+    REAKTOME_HOOK_PRE_DELATTR,  /* "__delattr__" (advisory, before mutation) */
+    REAKTOME_HOOK_COUNT
+} reaktome_hook;
+
+/* Dunder name of a hook id, e.g. "__reaktome_setitem__". */
+const char *activation_hook_name(reaktome_hook hook);
+
+/* Bit for a hook id in a hook mask. */
+#define REAKTOME_HOOK_BIT(hook) (1u << (hook))
+
+/* Mask of the hooks a dunders dict registers (entries other than None),
+   so patchers install only the trampolines that can fire them. 0 for
+   None or a non-dict. Never sets an exception. */
+unsigned int activation_hook_mask(PyObject *dunders);
+
+/* Which no-op writes an activation hears about, from its
+   "__reaktome_skip_noop__" dunder: absent/False reports everything, True or
+   "identity" skips storing the same object again, "equality" also skips
+   storing an equal one. */
+typedef enum {
+    REAKTOME_NOOP_REPORT,
+    REAKTOME_NOOP_IDENTITY,
+    REAKTOME_NOOP_EQUALITY,
+} reaktome_noop;
+
+/* Which keys and attribute names an activation hears about, from its
+   "__reaktome_filter__" dunder: absent/None passes everything, a str drops
+   str keys starting with that prefix, and a frozenset (or any other
+   iterable, frozen on merge) passes only its members. */
+typedef enum {
+    REAKTOME_FILTER_NONE,
+    REAKTOME_FILTER_PREFIX,
+    REAKTOME_FILTER_ALLOW,
+} reaktome_filter;
+
+/* Compiled view of one side-table entry. */
+typedef struct {
+    PyObject *dunders;                       /* merged dict (owned) */
+    PyObject *hooks[REAKTOME_HOOK_COUNT];    /* borrowed from dunders, or NULL */
+    reaktome_noop skip_noop;                 /* "__reaktome_skip_noop__" */
+    reaktome_filter filter;                  /* "__reaktome_filter__" */
+    PyObject *filter_arg;                    /* its prefix or set (borrowed), or NULL */
+} reaktome_hooks;
+
+/* One activation: the compiled hooks, the type it was counted against and
+   the install it holds. Side-table entries are allocated; native
+   containers embed one (zeroed, i.e. inactive, until first merged). */
+typedef struct {
+    reaktome_hooks hooks;    /* hooks.dunders is NULL while inactive */
+    PyTypeObject *type;      /* Py_TYPE(obj) when activated */
+    PyTypeObject *install;   /* install key held by this entry, or NULL */
+} reaktome_entry;
+
 /* Merge dunders dict into registry entry for obj (instance or type).
    If dunders is Py_None the entry for obj is cleared.
    Returns 0 on success, -1 on error (with Python exception set). */
@@ -18,6 +88,118 @@ int activation_merge(PyObject *obj, PyObject *dunders);
    are no hooks (convenient for callers). */
 PyObject *activation_get_hooks(PyObject *obj);
 
+/* Return a BORROWED pointer to the compiled hooks for obj (instance entry,
+   else type-level), or NULL. Only valid until the side-table changes, so
+   incref any callable before calling out to Python. Never sets an exception. */
+const reaktome_hooks *activation_lookup(PyObject *obj);
+
+/* Return 1 if obj (or its type) registered `hook`, 0 otherwise. For
+   trampolines that pick between a bulk hook and per-item hooks. */
+static inline int
+activation_has_hook(PyObject *obj, reaktome_hook hook)
+{
+    const reaktome_hooks *h = activation_lookup(obj);
+    return h && h->hooks[hook];
+}
+
+/* The no-op mode of obj's activation (REAKTOME_NOOP_REPORT when none). */
+static inline reaktome_noop
+activation_noop_mode(PyObject *obj)
+{
+    const reaktome_hooks *h = activation_lookup(obj);
+    return h ? h->skip_noop : REAKTOME_NOOP_REPORT;
+}
+
+/* Return 1 if replacing old with newv is a no-op obj asked not to hear
+   about, 0 otherwise. An absent old (NULL) is never a no-op. Equality may
+   run __eq__; errors count as a change. Never sets an exception. */
+int activation_is_noop(PyObject *obj, PyObject *old, PyObject *newv);
+
+/* activation_is_noop for a mode already read from the compiled hooks. */
+int activation_noop_matches(reaktome_noop mode, PyObject *old, PyObject *newv);
+
+/* Return 1 if key passes the compiled filter h (REAKTOME_FILTER_NONE
+   or a NULL key always do), 0 if it is filtered out. Lookup errors
+   (unhashable keys) count as passing. Never sets an exception. */
+int activation_filter_matches(const reaktome_hooks *h, PyObject *key);
+
+static inline int
+activation_filter_passes(const reaktome_hooks *h, PyObject *key)
+{
+    return !h || h->filter == REAKTOME_FILTER_NONE || !key ||
+           activation_filter_matches(h, key);
+}
+
+/* activation_filter_passes for obj's activation: trampolines check it
+   before snapshotting anything for a key the hooks will never see. */
+static inline int
+activation_key_passes(PyObject *obj, PyObject *key)
+{
+    return activation_filter_passes(activation_lookup(obj), key);
+}
+
+/* Number of live activations: side-table entries (instances and types)
+   plus observed native containers. */
+extern Py_ssize_t activation_live;
+
+/* Return 1 if obj has hooks (own entry or type-level), 0 otherwise.
+   Checks the per-type active counter before probing for the instance.
+   Never sets an exception. */
+int activation_has_hooks(PyObject *obj);
+
+/* activation_lookup behind the same per-type counter check, for
+   trampolines that need the compiled hooks of an observed object anyway:
+   NULL means unobserved. Same lifetime rules as activation_lookup. */
+const reaktome_hooks *activation_lookup_active(PyObject *obj);
+
+/* Fast-path guard for trampolines: unobserved objects fall straight
+   through to the original slot/method. */
+static inline int
+activation_is_active(PyObject *obj)
+{
+    return activation_live && activation_has_hooks(obj);
+}
+
+/* Evict side-table entries for instances of tp when they are deallocated.
+   Replaces tp_dealloc (static types) or tp_finalize (heap types) once;
+   instances of subclasses are covered too. Returns 0, or -1 with an
+   exception set. */
+int activation_evict_on_dealloc(PyTypeObject *tp);
+
+/* Number of entries in the side-table. */
+Py_ssize_t activation_size(void);
+
+/* Declare that instances of tp (and its subclasses) embed their
+   reaktome_entry `offset` bytes into the object. activation_merge then
+   activates them in place, and lookups read the entry from the object
+   instead of the side-table. The type's deallocator must call
+   activation_merge(obj, Py_None). Returns 0, or -1 with an exception set. */
+int activation_register_inline(PyTypeObject *tp, Py_ssize_t offset);
+
+/* Return 1 if obj embeds its entry (see activation_register_inline). */
+int activation_is_inline(PyObject *obj);
+
+/* Restores whatever a patcher installed under an install key. */
+typedef void (*reaktome_uninstall_fn)(PyTypeObject *install);
+
+/* Record that trampolines are installed under the key `install` (a type).
+   Several patchers may share a key; each callback is registered once and
+   all of them run at teardown. Returns 0, or -1 with an exception set. */
+int activation_install(PyTypeObject *install, reaktome_uninstall_fn uninstall);
+
+/* Return 1 if `uninstall` is registered under `install`. */
+int activation_installed(PyTypeObject *install, reaktome_uninstall_fn uninstall);
+
+/* activation_merge, plus: obj's entry holds the install key until it is
+   removed (deactivation, eviction or unpatch_all). When the last holder
+   goes, or dunders is Py_None and nothing holds it, the uninstall
+   callback runs and the key's eviction wrapper is removed. */
+int activation_merge_installed(PyObject *obj, PyObject *dunders, PyTypeObject *install);
+
+/* Clear the side-table and uninstall every registered install.
+   Returns 0, or -1 with an exception set. */
+int activation_unpatch_all(void);
+
 /* Convenience wrapper that treats the passed in pointer as a PyObject*:
    useful for type activation (calls activation_merge internally). */
 int reaktome_activate_type(PyTypeObject *type_or_obj, PyObject *dunders);
@@ -32,6 +214,31 @@ int reaktome_call_dunder(PyObject *self,
                          PyObject *old,
                          PyObject *newv);
 
+/* Same as reaktome_call_dunder but by hook id (no name lookup). */
+int reaktome_call_hook(PyObject *self,
+                       reaktome_hook hook,
+                       PyObject *key,
+                       PyObject *old,
+                       PyObject *newv);
+
+/* Same as reaktome_call_hook with an int key, which is only materialized
+   (from a shared table for small indices) when the hook is registered. */
+int reaktome_call_hook_index(PyObject *self,
+                             reaktome_hook hook,
+                             Py_ssize_t index,
+                             PyObject *old,
+                             PyObject *newv);
+
+/* Call a hook callable taken from reaktome_hooks (the caller holds a
+   reference) as callable(self, key, old, newv), timed like
+   reaktome_call_hook. Returns 0, or -1 with an exception set. */
+int reaktome_call_hook_object(PyObject *callable,
+                              PyObject *self,
+                              reaktome_hook hook,
+                              PyObject *key,
+                              PyObject *old,
+                              PyObject *newv);
+
 /* Optional helpers for type-level activation; simple implementations are allowed. */
 int activation_clear_type(PyTypeObject *type);
 int activation_set_type(PyTypeObject *type, PyObject *dunders);
@@ -2,12 +2,31 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include "activation.h"
+#include "ptr_table.h"
+#include "stats.h"
 #include "reaktome.h"
 #include <string.h>
 
+#if PY_VERSION_HEX >= 0x030D0000
+/* Still exported, but only declared by the internal headers since 3.13 */
+PyAPI_FUNC(int) _PyDict_SetItem_KnownHash(PyObject *mp, PyObject *key,
+                                          PyObject *item, Py_hash_t hash);
+PyAPI_FUNC(int) _PyDict_DelItem_KnownHash(PyObject *mp, PyObject *key,
+                                          Py_hash_t hash);
+#endif
+
 /* ---------- Saved original slot/method pointers ---------- */
-/* mapping slot */
-static int (*orig_mp_ass_subscript)(PyObject *, PyObject *, PyObject *) = NULL;
+/* PyDict_Type's own mp_ass_subscript, read before anything is patched.
+   While it is the saved original, stores can skip it and reuse the hash
+   computed for the old-value lookup. */
+static int (*native_mp_ass_subscript)(PyObject *, PyObject *, PyObject *) = NULL;
+
+/* mapping slot, per type: PyTypeObject* -> the mp_ass_subscript replaced
+   by the trampoline on that type (each patched dict type gets its own),
+   plus a permanent entry for ReaktomeDict holding native_mp_ass_subscript.
+   A subclass's entry belongs to its own install, which its activated
+   instances hold (so the type outlives it); see uninstall_dict_type. */
+static ptr_table slot_origs;
 
 /* ORIGINAL METHOD OBJECTS (descriptors) - saved from PyDict_Type.tp_dict */
 static PyObject *orig_update = NULL;    /* descriptor object for update */
@@ -16,53 +35,166 @@ static PyObject *orig_pop = NULL;       /* descriptor object for pop */
 static PyObject *orig_popitem = NULL;   /* descriptor object for popitem */
 static PyObject *orig_setdefault = NULL;/* descriptor object for setdefault */
 
+/* |= (only ReaktomeDict installs a trampoline for it) */
+static binaryfunc orig_nb_inplace_or = NULL;
+
+/* What is currently installed: a bit per entry of dict_wrappers shadowed
+   in PyDict_Type's dict (the slot trampolines are in slot_origs). Only
+   what some activation's hooks need is installed; the union grows until
+   the last holder goes. The orig_* pointers above outlive an uninstall. */
+static unsigned int methods_installed = 0;
+
+/* ---------- watcher backend state ---------- */
+typedef enum {
+    DICT_BACKEND_TRAMPOLINES,   /* patch PyDict_Type's slot and methods */
+    DICT_BACKEND_WATCHERS,      /* PyDict_Watch each observed dict */
+} dict_backend;
+
+static const char *const backend_names[] = {"trampolines", "watchers"};
+
+/* Id from PyDict_AddWatcher, or -1 when every watcher slot was taken. */
+static int watcher_id = -1;
+static dict_backend backend = DICT_BACKEND_TRAMPOLINES;
+
+/* Low bits of ma_version_tag flag the watchers of a dict (8 since 3.12). */
+#define DICT_WATCHER_BITS 0xffu
+
+static inline int
+dict_is_watched(PyObject *d)
+{
+_Py_COMP_DIAG_PUSH
+_Py_COMP_DIAG_IGNORE_DEPR_DECLS
+    return (((PyDictObject *)d)->ma_version_tag & DICT_WATCHER_BITS) != 0;
+_Py_COMP_DIAG_POP
+}
+
+/* Whether the trampolines report d: it is activated and not watched by
+   dict_watch_callback (activated under the watchers backend), which
+   reports it instead. Each dict is heard through one backend only. */
+static inline int
+tramp_observed(PyObject *d)
+{
+    if (!activation_is_active(d)) return 0;
+    if (watcher_id < 0) return 1;
+_Py_COMP_DIAG_PUSH
+_Py_COMP_DIAG_IGNORE_DEPR_DECLS
+    return !(((PyDictObject *)d)->ma_version_tag & (1u << watcher_id));
+_Py_COMP_DIAG_POP
+}
+
 /* reentrancy guard to avoid wrapper->hook->wrapper loops */
 static __thread int inprogress = 0;
 
 /* ---------- helper: call hook but swallow errors (advisory) ---------- */
 static inline void
 call_hook_advisory_dict(PyObject *self,
-                        const char *name,
+                        reaktome_hook hook,
                         PyObject *key,
                         PyObject *old,
                         PyObject *newv)
 {
-    if (reaktome_call_dunder(self, name, key, old, newv) < 0) {
+    if (reaktome_call_hook(self, hook, key, old, newv) < 0) {
         PyErr_Clear();
     }
 }
 
+/* ---------- helpers: single-hash access to the dict storage ---------- */
+
+/* Hash key once; -1 with an exception if it is unhashable. */
+static inline Py_hash_t
+key_hash(PyObject *key)
+{
+    if (PyUnicode_CheckExact(key)) {
+        Py_hash_t hash = ((PyASCIIObject *)key)->hash;
+        if (hash != -1) return hash;
+    }
+    return PyObject_Hash(key);
+}
+
+/* Current value stored under key (newref), or NULL when absent. Reads the
+   storage directly, so dict subclasses' __missing__ is never consulted.
+   Returns -1 with an exception on error, else 0. */
+static inline int
+stored_value(PyObject *self, PyObject *key, Py_hash_t hash, PyObject **old)
+{
+    *old = Py_XNewRef(_PyDict_GetItem_KnownHash(self, key, hash)); /* borrowed */
+    return (*old == NULL && PyErr_Occurred()) ? -1 : 0;
+}
+
+/* dict.pop raises KeyError(key); wrap tuples so they are not unpacked */
+static void
+set_key_error(PyObject *key)
+{
+    PyObject *tup = PyTuple_Pack(1, key);
+    if (!tup) return;
+    PyErr_SetObject(PyExc_KeyError, tup);
+    Py_DECREF(tup);
+}
+
 /* ---------- slot trampoline: mp_ass_subscript ---------- */
+
+static int tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value);
+
+/* The original behind the trampoline for instances of tp: saved by the
+   nearest type along the MRO that holds it, else the first slot there
+   that is not the trampoline (inherited after its owner was uninstalled).
+   Types before the first one whose slot is the trampoline override it in
+   Python and got here through super() (a ReaktomeDict subclass with its
+   own __setitem__), so the walk skips them. */
+static objobjargproc
+orig_ass_subscript(PyTypeObject *tp)
+{
+    PyObject *mro = tp->tp_mro;
+    Py_ssize_t k = 0;
+    while (k < PyTuple_GET_SIZE(mro)) {
+        PyMappingMethods *mp = ((PyTypeObject *)PyTuple_GET_ITEM(mro, k))->tp_as_mapping;
+        if (mp && mp->mp_ass_subscript == tramp_mp_ass_subscript) break;
+        k++;
+    }
+    if (k == PyTuple_GET_SIZE(mro)) k = 0;
+    for (; k < PyTuple_GET_SIZE(mro); k++) {
+        PyTypeObject *base = (PyTypeObject *)PyTuple_GET_ITEM(mro, k);
+        ptr_entry *e = ptr_table_find(&slot_origs, base);
+        if (e) return (objobjargproc)e->value;
+        PyMappingMethods *mp = base->tp_as_mapping;
+        if (mp && mp->mp_ass_subscript && mp->mp_ass_subscript != tramp_mp_ass_subscript)
+            return mp->mp_ass_subscript;
+    }
+    return native_mp_ass_subscript;
+}
+
 /* Handles d[key] = value  (value != NULL) and del d[key] (value == NULL) */
 static int
 tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
 {
-    /* Fetch old value if present (newref) for calling hooks later */
-    PyObject *old = NULL;
-    int got_old = 0;
+    objobjargproc orig = orig_ass_subscript(Py_TYPE(self));
 
-    /* Try to get old value; if missing that's okay for setitem */
-    old = PyObject_GetItem(self, key);  /* new ref or NULL with exception */
-    if (old) {
-        got_old = 1;
-    } else {
-        if (PyErr_Occurred()) {
-            if (PyErr_ExceptionMatches(PyExc_KeyError)) {
-                PyErr_Clear();
-            } else {
-                return -1;
-            }
-        }
-    }
+    /* Unobserved dicts skip the old-value lookup entirely */
+    if (!tramp_observed(self))
+        return orig(self, key, value);
+
+    /* Keys its filter drops likewise */
+    if (!activation_key_passes(self, key))
+        return orig(self, key, value);
+
+    /* One hash for both the old-value lookup and the store */
+    Py_hash_t hash = key_hash(key);
+    if (hash == -1) return -1;
+
+    PyObject *old;
+    if (stored_value(self, key, hash, &old) < 0) return -1;
+    int got_old = old != NULL;
 
     int rc = -1;
     /* perform the underlying operation */
-    if (orig_mp_ass_subscript) {
-        rc = orig_mp_ass_subscript(self, key, value);
+    int64_t t0 = REAKTOME_STATS_START();
+    if (orig == native_mp_ass_subscript) {
+        if (value == NULL) rc = _PyDict_DelItem_KnownHash(self, key, hash);
+        else rc = _PyDict_SetItem_KnownHash(self, key, value, hash);
     } else {
-        if (value == NULL) rc = PyObject_DelItem(self, key);
-        else rc = PyObject_SetItem(self, key, value);
+        rc = orig(self, key, value);
     }
+    REAKTOME_STATS_OP(self, value ? REAKTOME_OP_SETITEM : REAKTOME_OP_DELITEM, t0);
 
     if (rc < 0) {
         Py_XDECREF(old);
@@ -73,11 +205,11 @@ tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
     if (value == NULL) {
         /* delete: old must exist to signal; if old absent, do nothing */
         if (got_old) {
-            call_hook_advisory_dict(self, "__reaktome_delitem__", key, old, NULL);
+            call_hook_advisory_dict(self, REAKTOME_HOOK_DELITEM, key, old, NULL);
         }
-    } else {
+    } else if (!activation_is_noop(self, old, value)) {
         /* assignment */
-        call_hook_advisory_dict(self, "__reaktome_setitem__", key, old, value);
+        call_hook_advisory_dict(self, REAKTOME_HOOK_SETITEM, key, old, value);
     }
 
     Py_XDECREF(old);
@@ -86,274 +218,302 @@ tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
 
 /* ---------- method wrappers for dict methods ---------- */
 
-/* Helper: iterate mapping 'm' (newref) and call __reaktome_setitem__ for each item (k,v) */
+/* forward declarations for wrapper methoddefs (used when creating descriptors) */
+static PyObject *patched_dict_update(PyObject *self, PyObject *const *args,
+                                     Py_ssize_t nargs, PyObject *kwnames);
+static PyObject *patched_dict_clear(PyObject *self, PyObject *Py_UNUSED(ignored));
+static PyObject *patched_dict_pop(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject *patched_dict_popitem(PyObject *self, PyObject *Py_UNUSED(ignored));
+static PyObject *patched_dict_setdefault(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+
+/* methoddef templates for descriptors we'll create in type dict */
+static PyMethodDef update_def = {"update", (PyCFunction)(void(*)(void))patched_dict_update, METH_FASTCALL | METH_KEYWORDS, "update (trampoline)"};
+static PyMethodDef clear_def  = {"clear",  (PyCFunction)patched_dict_clear,  METH_NOARGS,  "clear (trampoline)"};
+static PyMethodDef pop_def    = {"pop", (PyCFunction)(void(*)(void))patched_dict_pop, METH_FASTCALL, "pop (trampoline)"};
+static PyMethodDef popitem_def= {"popitem",(PyCFunction)patched_dict_popitem,METH_NOARGS,  "popitem (trampoline)"};
+static PyMethodDef setdefault_def = {"setdefault", (PyCFunction)(void(*)(void))patched_dict_setdefault, METH_FASTCALL, "setdefault (trampoline)"};
+
+/* ---------- update: apply and report in one pass ---------- */
+/* Store one update pair the way dict.update does (no __setitem__), unless
+   the value stored under key is already `value`. The change goes to
+   `changes` as a (key, old, new) tuple when collecting for
+   __reaktome_update__, else straight to __reaktome_setitem__.
+   Returns -1 with an exception if the store failed. */
 static int
-call_setitem_for_mapping(PyObject *self, PyObject *mapping)
+update_pair(PyObject *self, PyObject *key, PyObject *value, PyObject *changes)
 {
-    if (!mapping) return 0;
-    PyObject *items = PyMapping_Items(mapping); /* newref */
-    if (!items) {
-        PyErr_Clear();
+    Py_hash_t hash = key_hash(key);
+    if (hash == -1) return -1;
+
+    /* filtered out: store quietly */
+    if (!activation_key_passes(self, key))
+        return _PyDict_SetItem_KnownHash(self, key, value, hash);
+
+    PyObject *old;
+    if (stored_value(self, key, hash, &old) < 0) return -1;
+    if (old == value) {
+        /* unchanged: nothing to store or report */
+        Py_DECREF(old);
         return 0;
     }
-    Py_ssize_t n = PyList_Size(items);
-    for (Py_ssize_t i = 0; i < n; i++) {
-        PyObject *tup = PyList_GetItem(items, i); /* borrowed */
-        if (!tup) continue;
-        PyObject *k = PyTuple_GetItem(tup, 0); /* borrowed */
-        PyObject *v = PyTuple_GetItem(tup, 1); /* borrowed */
-        /* call advisory; ignore errors */
-        call_hook_advisory_dict(self, "__reaktome_setitem__", k, NULL, v);
+    if (_PyDict_SetItem_KnownHash(self, key, value, hash) < 0) {
+        Py_XDECREF(old);
+        return -1;
     }
-    Py_DECREF(items);
-    return 0;
-}
 
-/* Build a new argument tuple with `self` prefixed to `args` */
-static PyObject *
-build_args_with_self(PyObject *self, PyObject *args)
-{
-    if (!args || !PyTuple_Check(args)) {
-        PyErr_SetString(PyExc_TypeError, "expected arg tuple");
-        return NULL;
+    if (activation_is_noop(self, old, value)) {
+        /* stored (an equal object), but not reported */
+        Py_DECREF(old);
+        return 0;
     }
-    Py_ssize_t n = PyTuple_Size(args);
-    PyObject *newt = PyTuple_New(n + 1);
-    if (!newt) return NULL;
-    Py_INCREF(self);
-    PyTuple_SET_ITEM(newt, 0, self); /* steals ref */
-    for (Py_ssize_t i = 0; i < n; i++) {
-        PyObject *it = PyTuple_GetItem(args, i); /* borrowed */
-        Py_INCREF(it);
-        PyTuple_SET_ITEM(newt, i + 1, it); /* steals ref */
+
+    if (changes) {
+        PyObject *change = PyTuple_Pack(3, key, old ? old : Py_None, value);
+        if (!change || PyList_Append(changes, change) < 0) PyErr_Clear();
+        Py_XDECREF(change);
+    } else {
+        call_hook_advisory_dict(self, REAKTOME_HOOK_SETITEM, key, old, value);
     }
-    return newt;
+    Py_XDECREF(old);
+    return 0;
 }
 
-/* forward declarations for wrapper methoddefs (used when creating descriptors) */
-static PyObject *patched_dict_update(PyObject *self, PyObject *args, PyObject *kwargs);
-static PyObject *patched_dict_clear(PyObject *self, PyObject *Py_UNUSED(ignored));
-static PyObject *patched_dict_pop(PyObject *self, PyObject *arg);
-static PyObject *patched_dict_popitem(PyObject *self, PyObject *Py_UNUSED(ignored));
-static PyObject *patched_dict_setdefault(PyObject *self, PyObject *args);
-
-/* methoddef templates for descriptors we'll create in type dict */
-static PyMethodDef update_def = {"update", (PyCFunction)patched_dict_update, METH_VARARGS | METH_KEYWORDS, "update (trampoline)"};
-static PyMethodDef clear_def  = {"clear",  (PyCFunction)patched_dict_clear,  METH_NOARGS,  "clear (trampoline)"};
-static PyMethodDef pop_def    = {"pop", (PyCFunction)patched_dict_pop, METH_VARARGS, "pop (trampoline)"};
-static PyMethodDef popitem_def= {"popitem",(PyCFunction)patched_dict_popitem,METH_NOARGS,  "popitem (trampoline)"};
-static PyMethodDef setdefault_def = {"setdefault", (PyCFunction)patched_dict_setdefault, METH_VARARGS, "setdefault (trampoline)"};
-
-/* update(self, ...) wrapper: best-effort — attempt to call setitem hook for input items */
-static PyObject *
-patched_dict_update(PyObject *self, PyObject *args, PyObject *kwargs)
+/* Walk the positional update argument like dict.update: exact dicts by
+   PyDict_Next, anything with keys() by key, else an iterable of pairs. */
+static int
+update_from_arg(PyObject *self, PyObject *arg, PyObject *changes)
 {
-    PyObject *res = NULL;
-    /* Save a reference to the first arg if present so we can inspect it */
-    PyObject *arg0 = NULL;
-    if (PyTuple_Size(args) >= 1) {
-        arg0 = PyTuple_GetItem(args, 0); /* borrowed */
-        Py_XINCREF(arg0);
-    }
-
-    /* call original: use saved descriptor + self-prefixed args to avoid calling our wrapper */
-    if (orig_update) {
-        PyObject *call_args = build_args_with_self(self, args);
-        if (!call_args) { Py_XDECREF(arg0); return NULL; }
-        res = PyObject_Call(orig_update, call_args, kwargs);
-        Py_DECREF(call_args);
-    } else {
-        /* fallback to calling Python-level attribute from the type */
-        PyObject *tp = (PyObject *)Py_TYPE(self);
-        PyObject *callable = PyObject_GetAttrString(tp, "update");
-        if (!callable) {
-            Py_XDECREF(arg0);
-            return NULL;
+    if (PyDict_CheckExact(arg)) {
+        Py_ssize_t pos = 0, size = PyDict_GET_SIZE(arg);
+        PyObject *key, *value;
+        while (PyDict_Next(arg, &pos, &key, &value)) {
+            Py_INCREF(key);
+            Py_INCREF(value);
+            int rc = update_pair(self, key, value, changes);
+            Py_DECREF(key);
+            Py_DECREF(value);
+            if (rc < 0) return -1;
+            /* a per-item hook may have touched the source */
+            if (PyDict_GET_SIZE(arg) != size) {
+                PyErr_SetString(PyExc_RuntimeError,
+                                "dict mutated during update");
+                return -1;
+            }
         }
-        res = PyObject_Call(callable, args, kwargs);
-        Py_DECREF(callable);
+        return 0;
     }
 
-    if (!res) {
-        Py_XDECREF(arg0);
-        return NULL;
+    PyObject *keys_fn = PyObject_GetAttrString(arg, "keys");
+    if (!keys_fn) {
+        if (!PyErr_ExceptionMatches(PyExc_AttributeError)) return -1;
+        PyErr_Clear();
     }
-    Py_DECREF(res);
 
-    /* After successful update, try to call setitem hook for items in arg0 (if mapping) */
-    if (arg0 && PyMapping_Check(arg0)) {
-        call_setitem_for_mapping(self, arg0);
-    } else if (arg0) {
-        /* If arg0 is an iterable of pairs, attempt to iterate it */
-        PyObject *it = PyObject_GetIter(arg0);
-        if (it) {
-            PyObject *item;
-            while ((item = PyIter_Next(it))) {
-                if (PyTuple_Check(item) && PyTuple_Size(item) == 2) {
-                    PyObject *k = PyTuple_GetItem(item, 0);
-                    PyObject *v = PyTuple_GetItem(item, 1);
-                    call_hook_advisory_dict(self, "__reaktome_setitem__", k, NULL, v);
-                }
-                Py_DECREF(item);
-            }
+    if (keys_fn) {
+        PyObject *keys = PyObject_CallNoArgs(keys_fn);
+        Py_DECREF(keys_fn);
+        if (!keys) return -1;
+        PyObject *it = PyObject_GetIter(keys);
+        Py_DECREF(keys);
+        if (!it) return -1;
+        PyObject *key;
+        while ((key = PyIter_Next(it))) {
+            PyObject *value = PyObject_GetItem(arg, key);
+            int rc = value ? update_pair(self, key, value, changes) : -1;
+            Py_DECREF(key);
+            Py_XDECREF(value);
+            if (rc < 0) { Py_DECREF(it); return -1; }
+        }
+        Py_DECREF(it);
+        return PyErr_Occurred() ? -1 : 0;
+    }
+
+    PyObject *it = PyObject_GetIter(arg);
+    if (!it) return -1;
+    PyObject *item;
+    for (Py_ssize_t i = 0; (item = PyIter_Next(it)); i++) {
+        PyObject *fast = PySequence_Fast(item, "");
+        if (!fast) {
+            if (PyErr_ExceptionMatches(PyExc_TypeError))
+                PyErr_Format(PyExc_TypeError,
+                             "cannot convert dictionary update "
+                             "sequence element #%zd to a sequence", i);
+            Py_DECREF(item);
             Py_DECREF(it);
-            if (PyErr_Occurred()) PyErr_Clear();
+            return -1;
         }
-    }
-
-    /* Also handle keyword arguments: call hook for each key=value pair */
-    if (kwargs && PyDict_Check(kwargs)) {
-        PyObject *key, *value;
-        Py_ssize_t pos = 0;
-        while (PyDict_Next(kwargs, &pos, &key, &value)) {
-            call_hook_advisory_dict(self, "__reaktome_setitem__", key, NULL, value);
+        Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+        int rc;
+        if (n != 2) {
+            PyErr_Format(PyExc_ValueError,
+                         "dictionary update sequence element #%zd "
+                         "has length %zd; 2 is required", i, n);
+            rc = -1;
+        } else {
+            PyObject *key = Py_NewRef(PySequence_Fast_GET_ITEM(fast, 0));
+            PyObject *value = Py_NewRef(PySequence_Fast_GET_ITEM(fast, 1));
+            rc = update_pair(self, key, value, changes);
+            Py_DECREF(key);
+            Py_DECREF(value);
         }
+        Py_DECREF(fast);
+        Py_DECREF(item);
+        if (rc < 0) { Py_DECREF(it); return -1; }
     }
-
-    Py_XDECREF(arg0);
-    Py_RETURN_NONE;
+    Py_DECREF(it);
+    return PyErr_Occurred() ? -1 : 0;
 }
 
-/* clear(self) wrapper: snapshot old items, call original, then fire delitem hooks per old item */
+/* update(self, [arg], **kwargs) wrapper. Observed dicts are updated here
+   rather than by the original, so each pair is hashed, compared with the
+   stored value, stored and reported in a single pass over the input
+   (which may be a one-shot iterator). Unchanged values are not reported.
+   With __reaktome_update__ registered, the applied changes are delivered
+   as one list of (key, old, new) tuples, even if the update failed part
+   way; otherwise __reaktome_setitem__ fires per pair. */
 static PyObject *
-patched_dict_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
+patched_dict_update(PyObject *self, PyObject *const *args,
+                    Py_ssize_t nargs, PyObject *kwnames)
 {
-    /* Snapshot current items (newref) */
-    PyObject *items = PyDict_Items(self); /* newref */
-    if (!items && PyErr_Occurred()) return NULL;
-
-    PyObject *res = NULL;
-
-    if (inprogress) {
-        /* If already in-progress, just forward to original to avoid recursion */
-        if (orig_clear) {
-            PyObject *empty = PyTuple_New(0);
-            if (!empty) { Py_XDECREF(items); return NULL; }
-            PyObject *call_args = build_args_with_self(self, empty);
-            Py_DECREF(empty);
-            if (!call_args) { Py_XDECREF(items); return NULL; }
-            res = PyObject_Call(orig_clear, call_args, NULL);
-            Py_DECREF(call_args);
-            if (!res) { Py_XDECREF(items); return NULL; }
-            Py_DECREF(res);
-            Py_XDECREF(items);
-            Py_RETURN_NONE;
-        } else {
-            PyDict_Clear(self);  /* void */
-            Py_XDECREF(items);
-            Py_RETURN_NONE;
-        }
-    }
+    if (orig_update && !tramp_observed(self))
+        return reaktome_call_orig(orig_update, self, args, nargs, kwnames);
 
-    inprogress = 1;
+    if (!reaktome_check_nargs("update", nargs, 0, 1)) return NULL;
+    PyObject *arg0 = nargs ? args[0] : NULL;
 
-    if (orig_clear) {
-        PyObject *empty = PyTuple_New(0);
-        if (!empty) { inprogress = 0; Py_XDECREF(items); return NULL; }
-        PyObject *call_args = build_args_with_self(self, empty);
-        Py_DECREF(empty);
-        if (!call_args) { inprogress = 0; Py_XDECREF(items); return NULL; }
-        res = PyObject_Call(orig_clear, call_args, NULL);
-        Py_DECREF(call_args);
-        if (!res) {
-            inprogress = 0;
-            Py_XDECREF(items);
-            return NULL;
-        }
-        Py_DECREF(res);
-    } else {
-        /* fallback: clear the dict (void) and continue to fire delitem hooks below */
-        PyDict_Clear(self);
+    PyObject *changes = NULL;
+    if (activation_has_hook(self, REAKTOME_HOOK_UPDATE)) {
+        changes = PyList_New(0);
+        if (!changes) return NULL;
     }
 
-    /* Fire delitem for each old item */
-    if (items) {
-        Py_ssize_t n = PyList_Size(items);
-        for (Py_ssize_t i = 0; i < n; i++) {
-            PyObject *tup = PyList_GetItem(items, i); /* borrowed */
-            if (!tup) continue;
-            PyObject *k = PyTuple_GetItem(tup, 0); /* borrowed */
-            PyObject *v = PyTuple_GetItem(tup, 1); /* borrowed */
-            call_hook_advisory_dict(self, "__reaktome_delitem__", k, v, NULL);
+    /* hold self: a per-item hook may deactivate it */
+    Py_INCREF(self);
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = arg0 ? update_from_arg(self, arg0, changes) : 0;
+    if (kwnames) {
+        /* keyword values follow the positionals; names are unique */
+        for (Py_ssize_t i = 0; rc == 0 && i < PyTuple_GET_SIZE(kwnames); i++)
+            rc = update_pair(self, PyTuple_GET_ITEM(kwnames, i), args[nargs + i], changes);
+    }
+    REAKTOME_STATS_OP(self, REAKTOME_OP_UPDATE, t0);
+
+    if (changes) {
+        if (PyList_GET_SIZE(changes)) {
+            PyObject *exc = PyErr_GetRaisedException();
+            call_hook_advisory_dict(self, REAKTOME_HOOK_UPDATE, NULL, NULL, changes);
+            PyErr_SetRaisedException(exc);
         }
-        Py_DECREF(items);
+        Py_DECREF(changes);
     }
+    Py_DECREF(self);
 
-    inprogress = 0;
+    if (rc < 0) return NULL;
     Py_RETURN_NONE;
 }
 
-/* patched_dict_pop: accept (key[, default]) */
+/* Move self's entries into a new dict and leave self empty. A combined
+   table is handed over by swapping the keys object, so nothing is copied
+   or increfed. Split tables (instance dicts) share their keys, and watched
+   dicts must see PyDict_EVENT_CLEARED, so those are copied and cleared. */
 static PyObject *
-patched_dict_pop(PyObject *self, PyObject *args)
+detach_contents(PyObject *self)
 {
-    PyObject *key;
-    PyObject *default_value = NULL;
-
-    /* Accept 1 or 2 positional args */
-    if (!PyArg_UnpackTuple(args, "pop", 1, 2, &key, &default_value)) {
-        return NULL;
-    }
+    PyDictObject *from = (PyDictObject *)self;
+    if (from->ma_values != NULL || dict_is_watched(self)) {
+        PyObject *copy = PyDict_Copy(self);
+        if (copy) PyDict_Clear(self);
+        return copy;
+    }
+
+    PyObject *detached = PyDict_New();
+    if (!detached) return NULL;
+    PyDictObject *to = (PyDictObject *)detached;
+    PyDictKeysObject *empty = to->ma_keys;
+    to->ma_keys = from->ma_keys;
+    to->ma_used = from->ma_used;
+    from->ma_keys = empty;
+    from->ma_used = 0;
+    /* new dicts start untracked; the entries may form cycles */
+    if (PyObject_GC_IsTracked(self) && !PyObject_GC_IsTracked(detached))
+        PyObject_GC_Track(detached);
+    return detached;
+}
 
-    /* Check whether the key existed before calling the original (so we know whether to fire hooks) */
-    int had_key = PyDict_Contains(self, key);
-    if (had_key < 0) {
-        return NULL; /* error from Contains */
-    }
+/* clear(self) wrapper: detach the entries, then one
+   __reaktome_clear__(self, None, old_contents, None) call with the
+   detached dict, or a delitem per old entry without it. */
+static PyObject *
+patched_dict_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (orig_clear && !tramp_observed(self))
+        return PyObject_Vectorcall(orig_clear, &self, 1, NULL);
 
-    PyObject *res = NULL;
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *old = detach_contents(self);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_CLEAR, t0);
+    if (!old) return NULL;
 
-    /* Call the saved original descriptor (orig_pop) with self-prefixed args to avoid recursion */
-    if (orig_pop) {
-        PyObject *call_args = build_args_with_self(self, args);
-        if (!call_args) return NULL;
-        res = PyObject_Call(orig_pop, call_args, NULL);
-        Py_DECREF(call_args);
+    if (PyDict_GET_SIZE(old) && activation_has_hook(self, REAKTOME_HOOK_CLEAR)) {
+        call_hook_advisory_dict(self, REAKTOME_HOOK_CLEAR, NULL, old, NULL);
     } else {
-        /* Fallback: call the type-level method */
-        PyObject *tp = (PyObject *)Py_TYPE(self);
-        PyObject *callable = PyObject_GetAttrString(tp, "pop");
-        if (!callable) return NULL;
-        res = PyObject_Call(callable, args, NULL);
-        Py_DECREF(callable);
+        /* old is private to this call, so hooks cannot disturb the walk */
+        Py_ssize_t pos = 0;
+        PyObject *k, *v;
+        while (PyDict_Next(old, &pos, &k, &v))
+            call_hook_advisory_dict(self, REAKTOME_HOOK_DELITEM, k, v, NULL);
     }
+    Py_DECREF(old);
+    Py_RETURN_NONE;
+}
 
-    if (!res) {
-        return NULL; /* propagate exception (KeyError when no default and missing key, etc.) */
+/* patched_dict_pop: accept (key[, default]) */
+static PyObject *
+patched_dict_pop(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (orig_pop && !tramp_observed(self))
+        return reaktome_call_orig(orig_pop, self, args, nargs, NULL);
+
+    /* Accept 1 or 2 positional args */
+    if (!reaktome_check_nargs("pop", nargs, 1, 2)) return NULL;
+    PyObject *key = args[0];
+    PyObject *default_value = nargs > 1 ? args[1] : NULL;
+
+    /* One hash for both the lookup and the deletion */
+    Py_hash_t hash = key_hash(key);
+    if (hash == -1) return NULL;
+
+    PyObject *old;
+    if (stored_value(self, key, hash, &old) < 0) return NULL;
+    if (!old) {
+        if (default_value) return Py_NewRef(default_value);
+        set_key_error(key);
+        return NULL;
     }
 
-    /* Only fire del hook if the key existed before (i.e., a real deletion occurred) */
-    if (had_key == 1) {
-        call_hook_advisory_dict(self, "__reaktome_delitem__", key, res, NULL);
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = _PyDict_DelItem_KnownHash(self, key, hash);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_POP, t0);
+    if (rc < 0) {
+        Py_DECREF(old);
+        return NULL;
     }
 
-    return res; /* newref from original pop */
+    call_hook_advisory_dict(self, REAKTOME_HOOK_DELITEM, key, old, NULL);
+    return old; /* newref */
 }
 
 /* popitem(self) wrapper: call original; if returns (k,v), fire del hook */
 static PyObject *
 patched_dict_popitem(PyObject *self, PyObject *Py_UNUSED(ignored))
 {
-    PyObject *res = NULL;
-
-    if (orig_popitem) {
-        PyObject *empty = PyTuple_New(0);
-        if (!empty) return NULL;
-        PyObject *call_args = build_args_with_self(self, empty);
-        Py_DECREF(empty);
-        if (!call_args) return NULL;
-        res = PyObject_Call(orig_popitem, call_args, NULL);
-        Py_DECREF(call_args);
-    } else {
-        /* fallback */
-        PyObject *callable = PyObject_GetAttrString((PyObject *)Py_TYPE(self), "popitem");
-        if (!callable) return NULL;
-        PyObject *empty = PyTuple_New(0);
-        if (!empty) { Py_DECREF(callable); return NULL; }
-        res = PyObject_Call(callable, empty, NULL);
-        Py_DECREF(empty);
-        Py_DECREF(callable);
-    }
+    /* dict always has popitem, so the original was saved at install */
+    if (!tramp_observed(self))
+        return PyObject_Vectorcall(orig_popitem, &self, 1, NULL);
+
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *res = PyObject_Vectorcall(orig_popitem, &self, 1, NULL);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_POPITEM, t0);
 
     if (!res) return NULL;
 
@@ -361,7 +521,7 @@ patched_dict_popitem(PyObject *self, PyObject *Py_UNUSED(ignored))
     if (PyTuple_Check(res) && PyTuple_Size(res) == 2) {
         PyObject *k = PyTuple_GetItem(res, 0); /* borrowed */
         PyObject *v = PyTuple_GetItem(res, 1); /* borrowed */
-        call_hook_advisory_dict(self, "__reaktome_delitem__", k, v, NULL);
+        call_hook_advisory_dict(self, REAKTOME_HOOK_DELITEM, k, v, NULL);
     }
 
     return res;
@@ -369,120 +529,353 @@ patched_dict_popitem(PyObject *self, PyObject *Py_UNUSED(ignored))
 
 /* setdefault(self, ...) wrapper: handle binding and call hook when key absent */
 static PyObject *
-patched_dict_setdefault(PyObject *self, PyObject *args) {
-    PyObject *key = NULL;
-    PyObject *default_value = Py_None;
-
-    /* peek at args */
-    if (!PyArg_UnpackTuple(args, "setdefault", 1, 2, &key, &default_value)) {
-        return NULL;
+patched_dict_setdefault(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    if (orig_setdefault && !tramp_observed(self))
+        return reaktome_call_orig(orig_setdefault, self, args, nargs, NULL);
+
+    if (!reaktome_check_nargs("setdefault", nargs, 1, 2)) return NULL;
+    PyObject *key = args[0];
+    PyObject *default_value = nargs > 1 ? args[1] : Py_None;
+
+    /* One hash for both the lookup and the insertion */
+    Py_hash_t hash = key_hash(key);
+    if (hash == -1) return NULL;
+
+    PyObject *old;
+    if (stored_value(self, key, hash, &old) < 0) return NULL;
+    if (old) return old; /* present: nothing changes */
+
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = _PyDict_SetItem_KnownHash(self, key, default_value, hash);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_SETDEFAULT, t0);
+    if (rc < 0) return NULL;
+
+    /* Only call hook if the key was absent before, and not from a hook */
+    if (!inprogress) {
+        inprogress = 1;
+        call_hook_advisory_dict(self, REAKTOME_HOOK_SETITEM, key, NULL, default_value);
+        inprogress = 0;
     }
+    return Py_NewRef(default_value);
+}
 
-    int had_key = PyDict_Contains(self, key);
-    if (had_key < 0) return NULL; /* error */
+/* ---------- install wrappers into PyDict_Type.tp_dict (shadowing in dict) ---------- */
 
-    if (inprogress) {
-        if (orig_setdefault) {
-            PyObject *call_args = build_args_with_self(self, args);
-            if (!call_args) return NULL;
-            PyObject *res = PyObject_Call(orig_setdefault, call_args, NULL);
-            Py_DECREF(call_args);
-            return res;
-        } else {
-            PyObject *callable = PyObject_GetAttrString((PyObject *)Py_TYPE(self), "setdefault");
-            if (!callable) return NULL;
-            PyObject *res = PyObject_Call(callable, args, NULL);
-            Py_DECREF(callable);
-            return res;
+#define HOOK(h) REAKTOME_HOOK_BIT(REAKTOME_HOOK_##h)
+
+/* Hooks the mp_ass_subscript trampoline can fire. */
+#define SLOT_HOOKS (HOOK(SETITEM) | HOOK(DELITEM))
+
+/* Method wrappers, each with the hooks it can fire. */
+static const struct {
+    const char *name;
+    PyMethodDef *def;
+    PyObject **orig;
+    unsigned int hooks;
+} dict_wrappers[] = {
+    {"update",     &update_def,     &orig_update,     HOOK(UPDATE) | HOOK(SETITEM)},
+    {"clear",      &clear_def,      &orig_clear,      HOOK(CLEAR) | HOOK(DELITEM)},
+    {"pop",        &pop_def,        &orig_pop,        HOOK(DELITEM)},
+    {"popitem",    &popitem_def,    &orig_popitem,    HOOK(DELITEM)},
+    {"setdefault", &setdefault_def, &orig_setdefault, HOOK(SETITEM)},
+};
+#define N_WRAPPERS (sizeof(dict_wrappers) / sizeof(dict_wrappers[0]))
+
+/* Shadow the wrappers that can fire one of `hooks` and are not in place
+   yet, saving the original descriptors first. */
+static int
+install_method_wrappers_for_dict(unsigned int hooks)
+{
+    PyObject *dict = PyType_GetDict(&PyDict_Type); /* newref */
+    if (!dict) return -1;
+
+    int rc = 0;
+    for (size_t i = 0; i < N_WRAPPERS && rc == 0; i++) {
+        if (!(dict_wrappers[i].hooks & hooks) || (methods_installed & (1u << i)))
+            continue;
+        PyObject *orig = PyDict_GetItemString(dict, dict_wrappers[i].name); /* borrowed */
+        if (orig) Py_XSETREF(*dict_wrappers[i].orig, Py_NewRef(orig));
+        PyObject *func = (PyObject *)PyDescr_NewMethod(&PyDict_Type, dict_wrappers[i].def);
+        if (!func) {
+            rc = -1;
+            break;
         }
+        rc = PyDict_SetItemString(dict, dict_wrappers[i].name, func);
+        Py_DECREF(func);
+        if (rc == 0) methods_installed |= 1u << i;
     }
+    Py_DECREF(dict);
 
-    inprogress = 1;
+    /* inform runtime */
+    PyType_Modified(&PyDict_Type);
+    return rc;
+}
 
-    PyObject *res;
-    if (orig_setdefault) {
-        PyObject *call_args = build_args_with_self(self, args);
-        if (!call_args) { inprogress = 0; return NULL; }
-        res = PyObject_Call(orig_setdefault, call_args, NULL);
-        Py_DECREF(call_args);
-    } else {
-        PyObject *callable = PyObject_GetAttrString((PyObject *)Py_TYPE(self), "setdefault");
-        if (!callable) { inprogress = 0; return NULL; }
-        res = PyObject_Call(callable, args, NULL);
-        Py_DECREF(callable);
-    }
+/* ---------- uninstall: put back the pristine slot and methods ---------- */
 
-    if (!res) {
-        inprogress = 0;
-        return NULL;
-    }
+static void
+restore_slot(PyTypeObject *tp)
+{
+    if (!ptr_table_find(&slot_origs, tp)) return;
+    objobjargproc orig = (objobjargproc)ptr_table_pop(&slot_origs, tp);
+    PyMappingMethods *mp = tp->tp_as_mapping;
+    if (mp->mp_ass_subscript == tramp_mp_ass_subscript) mp->mp_ass_subscript = orig;
+    PyType_Modified(tp);
+}
 
-    if (had_key == 0) {
-        /* Only call hook if the key was absent before */
-        call_hook_advisory_dict(self, "__reaktome_setitem__", key, NULL, res);
+/* PyDict_Type's install: the method wrappers and dict's own slot. dict is
+   static, so this only runs on unpatch_all (see activation.c). */
+static void
+uninstall_dict(PyTypeObject *Py_UNUSED(install))
+{
+    if (methods_installed) {
+        PyObject *dict = PyType_GetDict(&PyDict_Type); /* newref */
+        for (size_t i = 0; dict && i < N_WRAPPERS; i++) {
+            PyObject *orig = *dict_wrappers[i].orig;
+            if ((methods_installed & (1u << i)) && orig &&
+                PyDict_SetItemString(dict, dict_wrappers[i].name, orig) < 0)
+                PyErr_Clear();
+        }
+        Py_XDECREF(dict);
+        methods_installed = 0;
+        PyType_Modified(&PyDict_Type);
     }
+    restore_slot(&PyDict_Type);
+}
 
-    inprogress = 0;
-    return res;
+/* A dict subclass's install: its slot, once its last activated instance
+   is gone. ReaktomeDict never gets one. */
+static void
+uninstall_dict_type(PyTypeObject *tp)
+{
+    restore_slot(tp);
 }
 
-/* ---------- install wrappers into PyDict_Type.tp_dict (shadowing in dict) ---------- */
+/* ---------- native subclass: ReaktomeDict ----------
+   A dict subclass whose mp_ass_subscript and methods are the trampolines
+   above, plus |= reported like update, with its activation entry in the
+   object. It is never watched, so the trampolines always report it. Its
+   slot_origs entry is PyDict_Type's own store, whatever else is patched;
+   the method originals start at PyDict_Type's own (see native_dict_init). */
+
+typedef struct {
+    PyDictObject dict;
+    reaktome_entry entry;
+} reaktome_dict;
+
+/* nb_inplace_or trampoline: d |= other, applied and reported by update */
+static PyObject *
+tramp_nb_inplace_or(PyObject *self, PyObject *other)
+{
+    if (!tramp_observed(self)) return orig_nb_inplace_or(self, other);
+
+    PyObject *res = patched_dict_update(self, &other, 1, NULL);
+    if (!res) return NULL;
+    Py_DECREF(res);
+    return Py_NewRef(self);
+}
+
+static void
+native_dict_dealloc(PyObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    activation_merge(self, Py_None);
+    PyDict_Type.tp_dealloc(self);
+}
+
+static int
+native_dict_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(((reaktome_dict *)self)->entry.hooks.dunders);
+    return PyDict_Type.tp_traverse(self, visit, arg);
+}
+
+static int
+native_dict_clear(PyObject *self)
+{
+    activation_merge(self, Py_None);
+    return PyDict_Type.tp_clear(self);
+}
+
+static PyMappingMethods native_dict_as_mapping = {
+    .mp_ass_subscript = tramp_mp_ass_subscript,
+};
+
+static PyNumberMethods native_dict_as_number = {
+    .nb_inplace_or = tramp_nb_inplace_or,
+};
 
+/* Filled from dict_wrappers at module init */
+static PyMethodDef native_dict_methods[N_WRAPPERS + 1];
+
+static PyTypeObject ReaktomeDict_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "_reaktome.ReaktomeDict",
+    .tp_basicsize = sizeof(reaktome_dict),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "dict with its reaktome hooks built in",
+    .tp_dealloc = native_dict_dealloc,
+    .tp_traverse = native_dict_traverse,
+    .tp_clear = native_dict_clear,
+    .tp_as_mapping = &native_dict_as_mapping,
+    .tp_as_number = &native_dict_as_number,
+    .tp_methods = native_dict_methods,
+};
+
+/* Save PyDict_Type's own slots and methods as the originals, unless an
+   install already did, then ready and register ReaktomeDict. */
 static int
-install_method_wrappers_for_dict(void)
+native_dict_init(PyObject *m)
 {
-    PyObject *dict = PyType_GetDict(&PyDict_Type); /* borrowed */
+    orig_nb_inplace_or = PyDict_Type.tp_as_number->nb_inplace_or;
+
+    PyObject *dict = PyType_GetDict(&PyDict_Type); /* newref */
     if (!dict) return -1;
+    for (size_t i = 0; i < N_WRAPPERS; i++) {
+        native_dict_methods[i] = *dict_wrappers[i].def;
+        if (*dict_wrappers[i].orig) continue;
+        PyObject *orig = PyDict_GetItemString(dict, dict_wrappers[i].name); /* borrowed */
+        *dict_wrappers[i].orig = Py_XNewRef(orig);
+    }
+    Py_DECREF(dict);
+
+    ReaktomeDict_Type.tp_base = &PyDict_Type;
+    if (PyType_Ready(&ReaktomeDict_Type) < 0) return -1;
+    if (!ptr_table_insert(&slot_origs, &ReaktomeDict_Type,
+                          (void *)native_mp_ass_subscript)) return -1;
+    if (activation_register_inline(&ReaktomeDict_Type,
+                                   offsetof(reaktome_dict, entry)) < 0) return -1;
+    return PyModule_AddObjectRef(m, "ReaktomeDict", (PyObject *)&ReaktomeDict_Type);
+}
+
+/* ---------- Python wrapper: py_patch_dict(instance, dunders) ---------- */
+/* ---------- watcher backend ----------
+   PyDict_Watch costs nothing for dicts that are not watched, so nothing
+   global is patched. The callback runs *before* the dict changes, so
+   hooks get the same (key, old, new) as from the trampolines, but the
+   dict still holds the old state. While the trampolines are installed
+   they report every observed dict and the callback stays quiet, so a
+   change is never reported twice. */
+
+/* Per-item setitem for every entry of src, or one __reaktome_update__
+   call: src is the dict being cloned into the (empty) watched dict. */
+static void
+report_clone(PyObject *self, PyObject *src)
+{
+    PyObject *items = PyDict_Items(src); /* snapshot: hooks may touch src */
+    if (!items) { PyErr_Clear(); return; }
+    Py_ssize_t n = PyList_GET_SIZE(items);
+    if (activation_has_hook(self, REAKTOME_HOOK_UPDATE)) {
+        PyObject *changes = PyList_New(0);
+        for (Py_ssize_t i = 0; changes && i < n; i++) {
+            PyObject *kv = PyList_GET_ITEM(items, i);
+            if (!activation_key_passes(self, PyTuple_GET_ITEM(kv, 0))) continue;
+            PyObject *change = PyTuple_Pack(3, PyTuple_GET_ITEM(kv, 0), Py_None,
+                                            PyTuple_GET_ITEM(kv, 1));
+            if (!change || PyList_Append(changes, change) < 0) Py_CLEAR(changes);
+            Py_XDECREF(change);
+        }
+        if (!changes)
+            PyErr_Clear();
+        else if (PyList_GET_SIZE(changes))
+            call_hook_advisory_dict(self, REAKTOME_HOOK_UPDATE, NULL, NULL, changes);
+        Py_XDECREF(changes);
+    } else {
+        for (Py_ssize_t i = 0; i < n; i++) {
+            PyObject *kv = PyList_GET_ITEM(items, i);
+            call_hook_advisory_dict(self, REAKTOME_HOOK_SETITEM,
+                                    PyTuple_GET_ITEM(kv, 0), NULL,
+                                    PyTuple_GET_ITEM(kv, 1));
+        }
+    }
+    Py_DECREF(items);
+}
 
-    PyObject *orig;
-    PyObject *func;
-
-    /* update */
-    orig = PyDict_GetItemString(dict, "update"); /* borrowed */
-    if (orig) { Py_XINCREF(orig); orig_update = orig; }
-    func = (PyObject *)PyDescr_NewMethod(&PyDict_Type, &update_def);
-    if (!func) return -1;
-    if (PyDict_SetItemString(dict, "update", func) < 0) { Py_DECREF(func); return -1; }
-    Py_DECREF(func);
-
-    /* clear */
-    orig = PyDict_GetItemString(dict, "clear");
-    if (orig) { Py_XINCREF(orig); orig_clear = orig; }
-    func = (PyObject *)PyDescr_NewMethod(&PyDict_Type, &clear_def);
-    if (!func) return -1;
-    if (PyDict_SetItemString(dict, "clear", func) < 0) { Py_DECREF(func); return -1; }
-    Py_DECREF(func);
-
-    /* pop */
-    orig = PyDict_GetItemString(dict, "pop");
-    if (orig) { Py_XINCREF(orig); orig_pop = orig; }
-    func = (PyObject *)PyDescr_NewMethod(&PyDict_Type, &pop_def);
-    if (!func) return -1;
-    if (PyDict_SetItemString(dict, "pop", func) < 0) { Py_DECREF(func); return -1; }
-    Py_DECREF(func);
-
-    /* popitem */
-    orig = PyDict_GetItemString(dict, "popitem");
-    if (orig) { Py_XINCREF(orig); orig_popitem = orig; }
-    func = (PyObject *)PyDescr_NewMethod(&PyDict_Type, &popitem_def);
-    if (!func) return -1;
-    if (PyDict_SetItemString(dict, "popitem", func) < 0) { Py_DECREF(func); return -1; }
-    Py_DECREF(func);
-
-    /* setdefault */
-    orig = PyDict_GetItemString(dict, "setdefault");
-    if (orig) { Py_XINCREF(orig); orig_setdefault = orig; }
-    func = (PyObject *)PyDescr_NewMethod(&PyDict_Type, &setdefault_def);
-    if (!func) return -1;
-    if (PyDict_SetItemString(dict, "setdefault", func) < 0) { Py_DECREF(func); return -1; }
-    Py_DECREF(func);
+/* One __reaktome_clear__ with a copy (the dict is emptied once we return),
+   or a delitem per entry. */
+static void
+report_cleared(PyObject *self)
+{
+    PyObject *old = PyDict_Copy(self);
+    if (!old) { PyErr_Clear(); return; }
+    if (PyDict_GET_SIZE(old) && activation_has_hook(self, REAKTOME_HOOK_CLEAR)) {
+        call_hook_advisory_dict(self, REAKTOME_HOOK_CLEAR, NULL, old, NULL);
+    } else {
+        Py_ssize_t pos = 0;
+        PyObject *k, *v;
+        while (PyDict_Next(old, &pos, &k, &v))
+            call_hook_advisory_dict(self, REAKTOME_HOOK_DELITEM, k, v, NULL);
+    }
+    Py_DECREF(old);
+}
 
-    /* inform runtime */
-    PyType_Modified(&PyDict_Type);
+static int
+dict_watch_callback(PyDict_WatchEvent event, PyObject *self,
+                    PyObject *key, PyObject *new_value)
+{
+    if (!activation_is_active(self)) return 0;
+
+    /* mutations can happen with an exception pending (e.g. in unwinding) */
+    PyObject *exc = PyErr_GetRaisedException();
+    PyObject *old = NULL;
+    switch (event) {
+    case PyDict_EVENT_ADDED:
+        call_hook_advisory_dict(self, REAKTOME_HOOK_SETITEM, key, NULL, new_value);
+        break;
+    case PyDict_EVENT_MODIFIED:
+    case PyDict_EVENT_DELETED:
+        if (!activation_key_passes(self, key)) break;
+        old = Py_XNewRef(PyDict_GetItemWithError(self, key)); /* borrowed */
+        if (!old) {
+            PyErr_Clear();
+        } else if (event == PyDict_EVENT_MODIFIED) {
+            if (!activation_is_noop(self, old, new_value))
+                call_hook_advisory_dict(self, REAKTOME_HOOK_SETITEM, key, old, new_value);
+        } else {
+            call_hook_advisory_dict(self, REAKTOME_HOOK_DELITEM, key, old, NULL);
+        }
+        Py_XDECREF(old);
+        break;
+    case PyDict_EVENT_CLONED:
+        /* the source dict arrives as `key` */
+        report_clone(self, key);
+        break;
+    case PyDict_EVENT_CLEARED:
+        report_cleared(self);
+        break;
+    case PyDict_EVENT_DEALLOCATED:
+        /* stands in for the eviction wrapper, which is never installed */
+        activation_merge(self, Py_None);
+        break;
+    }
+    PyErr_SetRaisedException(exc);
     return 0;
 }
 
-/* ---------- Python wrapper: py_patch_dict(instance, dunders) ---------- */
+/* dict_backend([name]): return the backend patch_dict uses, optionally
+   switching to `name` first ("trampolines" or "watchers"). Applies to
+   later activations; installed trampolines still serve every observed
+   dict until their last holder goes. */
+static PyObject *
+py_dict_backend(PyObject *self, PyObject *args)
+{
+    const char *name = NULL;
+    if (!PyArg_ParseTuple(args, "|s:dict_backend", &name)) return NULL;
+    PyObject *prev = PyUnicode_FromString(backend_names[backend]);
+    if (!prev || !name) return prev;
+
+    if (strcmp(name, "trampolines") == 0) {
+        backend = DICT_BACKEND_TRAMPOLINES;
+    } else if (strcmp(name, "watchers") == 0 && watcher_id >= 0) {
+        backend = DICT_BACKEND_WATCHERS;
+    } else {
+        PyErr_Format(PyExc_ValueError, "dict_backend: %s backend not available", name);
+        Py_DECREF(prev);
+        return NULL;
+    }
+    return prev;
+}
+
 static PyObject *
 py_patch_dict(PyObject *self, PyObject *args)
 {
@@ -496,32 +889,60 @@ py_patch_dict(PyObject *self, PyObject *args)
         return NULL;
     }
 
+    /* ReaktomeDict has the trampolines built in */
+    if (activation_is_inline(inst)) {
+        if (activation_merge(inst, dunders) < 0) return NULL;
+        Py_RETURN_NONE;
+    }
+
+    /* Clearing never installs anything; it may uninstall */
+    if (dunders == Py_None) {
+        if (watcher_id >= 0 && PyDict_Unwatch(watcher_id, inst) < 0) return NULL;
+        if (activation_merge_installed(inst, Py_None, Py_TYPE(inst)) < 0) return NULL;
+        Py_RETURN_NONE;
+    }
+
+    if (backend == DICT_BACKEND_WATCHERS) {
+        if (PyDict_Watch(watcher_id, inst) < 0) return NULL;
+        if (activation_merge(inst, dunders) < 0) return NULL;
+        Py_RETURN_NONE;
+    }
+
     /* Ensure dict type ready */
     if (PyType_Ready(Py_TYPE(inst)) < 0) return NULL;
 
-    /* Install slot trampoline once */
-    if (!orig_mp_ass_subscript) {
-        PyMappingMethods *mp = Py_TYPE(inst)->tp_as_mapping;
+    /* Evict side-table entries when dicts (and dict subclasses) die */
+    if (activation_evict_on_dealloc(&PyDict_Type) < 0) return NULL;
+
+    /* Install what these hooks need; earlier installs stay. The slot
+       trampoline goes on inst's own type, keeping that type's original */
+    unsigned int hooks = activation_hook_mask(dunders);
+    PyTypeObject *tp = Py_TYPE(inst);
+    if ((hooks & SLOT_HOOKS) && !ptr_table_find(&slot_origs, tp)) {
+        PyMappingMethods *mp = tp->tp_as_mapping;
         if (!mp) {
             PyErr_SetString(PyExc_RuntimeError, "patch_dict: type has no mapping methods");
             return NULL;
         }
-        orig_mp_ass_subscript = mp->mp_ass_subscript;
+        if (!ptr_table_insert(&slot_origs, tp, (void *)orig_ass_subscript(tp))) return NULL;
         mp->mp_ass_subscript = tramp_mp_ass_subscript;
         /* Tell runtime the type dict changed */
-        PyType_Modified(Py_TYPE(inst));
+        PyType_Modified(tp);
     }
 
-    /* Install method wrappers once */
-    if (!orig_update) {
-        if (install_method_wrappers_for_dict() < 0) {
-            PyErr_SetString(PyExc_RuntimeError, "patch_dict: failed to install method wrappers");
-            return NULL;
-        }
+    if (install_method_wrappers_for_dict(hooks) < 0) {
+        PyErr_SetString(PyExc_RuntimeError, "patch_dict: failed to install method wrappers");
+        return NULL;
     }
 
-    /* Merge hooks for this instance (activation side-table). dunders may be None to clear. */
-    if (activation_merge(inst, dunders) < 0) {
+    /* The wrappers live in PyDict_Type; see uninstall_dict */
+    if (activation_install(&PyDict_Type, uninstall_dict) < 0) return NULL;
+    /* A subclass's slot is its own install, held by its instances */
+    if (tp != &PyDict_Type && activation_install(tp, uninstall_dict_type) < 0)
+        return NULL;
+
+    /* Merge hooks for this instance (activation side-table). */
+    if (activation_merge_installed(inst, dunders, tp) < 0) {
         return NULL;
     }
 
@@ -531,6 +952,7 @@ py_patch_dict(PyObject *self, PyObject *args)
 /* ---------- static PyMethodDef objects (file scope) ---------- */
 static PyMethodDef dict_methods[] = {
     {"patch_dict", (PyCFunction)py_patch_dict, METH_VARARGS, "Activate dict instance with dunders (or None to clear)"},
+    {"dict_backend", (PyCFunction)py_dict_backend, METH_VARARGS, "Return the dict backend, optionally switching first; returns the previous one"},
     {NULL, NULL, 0, NULL}
 };
 
@@ -539,6 +961,15 @@ int
 reaktome_patch_dict(PyObject *m)
 {
     if (!m) return -1;
+    if (!native_mp_ass_subscript)
+        native_mp_ass_subscript = PyDict_Type.tp_as_mapping->mp_ass_subscript;
+    /* Watchers are opt-in (dict_backend("watchers")): their hooks run
+       before the change, so trampolines stay the default */
+    if (watcher_id < 0) {
+        watcher_id = PyDict_AddWatcher(dict_watch_callback);
+        if (watcher_id < 0) PyErr_Clear();
+    }
     if (PyModule_AddFunctions(m, dict_methods) < 0) return -1;
+    if (native_dict_init(m) < 0) return -1;
     return 0;
 }
@@ -2,27 +2,175 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include "activation.h"
+#include "ptr_table.h"
+#include "stats.h"
 #include "reaktome.h"
 
-/* ---------- saved original slot pointers ---------- */
-static int (*orig_sq_ass_item)(PyObject *, Py_ssize_t, PyObject *) = NULL;
+/* ---------- per-type installs ----------
+   Trampolines are installed on the concrete type of each patched list
+   (list itself or a subclass), never on its bases, and each install keeps
+   the originals it replaced (list_install, below). A trampoline finds the
+   original to forward to through the instance's type, so observing a
+   subclass leaves every other list type untouched. The exception is a
+   method the subclass overrides: its wrapper goes below the override
+   (method_target), where the override's super() call finds it. */
+
+/* Shadowed methods, as indices into list_wrappers and list_install */
+enum {
+    W_APPEND, W_EXTEND, W_INSERT, W_POP, W_REMOVE, W_CLEAR, W_SORT, W_REVERSE,
+    N_SHADOWED
+};
+
+static ssizeobjargproc orig_sq_ass_item(PyTypeObject *tp);
+static binaryfunc orig_sq_inplace_concat(PyTypeObject *tp);
+static ssizeargfunc orig_sq_inplace_repeat(PyTypeObject *tp);
 #if PY_VERSION_HEX >= 0x03090000
-static int (*orig_mp_ass_subscript)(PyObject *, PyObject *, PyObject *) = NULL;
+static objobjargproc orig_mp_ass_subscript(PyTypeObject *tp);
 #else
-static int (*orig_sq_ass_slice)(PyObject *, Py_ssize_t, Py_ssize_t, PyObject *) = NULL;
+static ssizessizeobjargproc orig_sq_ass_slice(PyTypeObject *tp);
 #endif
+static PyObject *orig_method(PyTypeObject *tp, int which);
+static void uninstall_list_type(PyTypeObject *tp);
 
 /* ---------- helper: call hook but swallow errors (advisory) ---------- */
 static inline void
 call_hook_advisory(PyObject *self,
-                   const char *name,
+                   reaktome_hook hook,
                    PyObject *key,
                    PyObject *old,
                    PyObject *newv)
 {
-    if (reaktome_call_dunder(self, name, key, old, newv) < 0) {
+    if (reaktome_call_hook(self, hook, key, old, newv) < 0) {
+        PyErr_Clear();
+    }
+}
+
+/* Same with an index key, allocated only if the hook is registered. */
+static inline void
+call_index_hook_advisory(PyObject *self,
+                         reaktome_hook hook,
+                         Py_ssize_t index,
+                         PyObject *old,
+                         PyObject *newv)
+{
+    if (reaktome_call_hook_index(self, hook, index, old, newv) < 0) {
+        PyErr_Clear();
+    }
+}
+
+/* ---------- helpers: report a bulk replacement ---------- */
+/* Per-item hooks for old_items (a list, or NULL for none) replaced by
+   new_items (a list) at index start: a setitem per new item, then a delitem
+   per old item, keyed by index when `keyed` and by None otherwise.
+   Advisory: errors are swallowed. */
+static void
+report_items(PyObject *self, Py_ssize_t start,
+             PyObject *old_items, PyObject *new_items, int keyed)
+{
+    Py_ssize_t n = PyList_GET_SIZE(new_items);
+    for (Py_ssize_t j = 0; j < n; j++) {
+        PyObject *item = PyList_GET_ITEM(new_items, j);
+        if (keyed) call_index_hook_advisory(self, REAKTOME_HOOK_SETITEM, start + j, NULL, item);
+        else call_hook_advisory(self, REAKTOME_HOOK_SETITEM, NULL, NULL, item);
+    }
+
+    n = old_items ? PyList_GET_SIZE(old_items) : 0;
+    for (Py_ssize_t j = 0; j < n; j++) {
+        PyObject *item = PyList_GET_ITEM(old_items, j);
+        if (keyed) call_index_hook_advisory(self, REAKTOME_HOOK_DELITEM, start + j, item, NULL);
+        else call_hook_advisory(self, REAKTOME_HOOK_DELITEM, NULL, item, NULL);
+    }
+}
+
+/* Same for a contiguous range, except that instances which registered
+   __reaktome_setslice__ get one call with (start, old_items, new_items). */
+static void
+report_slice(PyObject *self, Py_ssize_t start,
+             PyObject *old_items, PyObject *new_items, int keyed)
+{
+    if (!activation_has_hook(self, REAKTOME_HOOK_SETSLICE)) {
+        report_items(self, start, old_items, new_items, keyed);
+        return;
+    }
+
+    PyObject *where = PyLong_FromSsize_t(start);
+    PyObject *old = old_items ? Py_NewRef(old_items) : PyList_New(0);
+    if (where && old) {
+        call_hook_advisory(self, REAKTOME_HOOK_SETSLICE, where, old, new_items);
+    } else {
         PyErr_Clear();
     }
+    Py_XDECREF(where);
+    Py_XDECREF(old);
+}
+
+/* ---------- helper: permutation applied by a sort ---------- */
+
+typedef struct {
+    PyObject *item;
+    Py_ssize_t idx;
+} perm_pair;
+
+static int
+perm_pair_cmp(const void *a, const void *b)
+{
+    const perm_pair *x = a, *y = b;
+    if (x->item != y->item)
+        return (uintptr_t)x->item < (uintptr_t)y->item ? -1 : 1;
+    return (x->idx > y->idx) - (x->idx < y->idx);
+}
+
+/* New list perm with perm[i] = index in `before` of the item now at
+   self[i], matched by identity in O(n log n). Repeated objects are matched
+   in their original order, as a stable sort leaves them. Returns NULL,
+   without an exception, if nothing moved or if self no longer holds
+   exactly those items. */
+static PyObject *
+sort_permutation(PyObject *self, PyObject *before)
+{
+    Py_ssize_t n = PyList_GET_SIZE(before);
+    if (PyList_GET_SIZE(self) != n) return NULL;
+
+    PyObject *perm = NULL;
+    perm_pair *pairs = PyMem_New(perm_pair, n);
+    Py_ssize_t *next = PyMem_New(Py_ssize_t, n); /* next unused entry of a run */
+    if (!pairs || !next) goto done;
+
+    for (Py_ssize_t i = 0; i < n; i++) {
+        pairs[i].item = PyList_GET_ITEM(before, i);
+        pairs[i].idx = i;
+        next[i] = i;
+    }
+    qsort(pairs, (size_t)n, sizeof(perm_pair), perm_pair_cmp);
+
+    int moved = 0;
+    perm = PyList_New(n);
+    if (!perm) goto fail;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item = PyList_GET_ITEM(self, i);
+        Py_ssize_t lo = 0, hi = n;
+        while (lo < hi) {
+            Py_ssize_t mid = lo + (hi - lo) / 2;
+            if ((uintptr_t)pairs[mid].item < (uintptr_t)item) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == n || pairs[lo].item != item) goto fail;
+        Py_ssize_t k = next[lo]++;
+        if (k >= n || pairs[k].item != item) goto fail;
+        PyObject *idx = PyLong_FromSsize_t(pairs[k].idx);
+        if (!idx) goto fail;
+        PyList_SET_ITEM(perm, i, idx);
+        moved |= pairs[k].idx != i;
+    }
+    if (moved) goto done;
+
+fail:
+    Py_CLEAR(perm);
+    PyErr_Clear();
+done:
+    PyMem_Free(pairs);
+    PyMem_Free(next);
+    return perm;
 }
 
 /* ---------- slot trampolines ---------- */
@@ -31,38 +179,35 @@ call_hook_advisory(PyObject *self,
 static int
 tramp_sq_ass_item(PyObject *self, Py_ssize_t i, PyObject *v)
 {
+    ssizeobjargproc orig = orig_sq_ass_item(Py_TYPE(self));
+    if (!activation_is_active(self))
+        return orig(self, i, v);
+
     if (v == NULL) {
         PyObject *old = PySequence_GetItem(self, i); /* new ref */
         if (!old) return -1;
 
-        int rc;
-        if (orig_sq_ass_item) rc = orig_sq_ass_item(self, i, NULL);
-        else rc = PySequence_DelItem(self, i);
+        int64_t t0 = REAKTOME_STATS_START();
+        int rc = orig(self, i, NULL);
+        REAKTOME_STATS_OP(self, REAKTOME_OP_DELITEM, t0);
 
         if (rc < 0) { Py_DECREF(old); return -1; }
 
-        PyObject *key = PyLong_FromSsize_t(i);
-        if (key) {
-            call_hook_advisory(self, "__reaktome_delitem__", key, old, NULL);
-            Py_DECREF(key);
-        }
+        call_index_hook_advisory(self, REAKTOME_HOOK_DELITEM, i, old, NULL);
         Py_DECREF(old);
         return 0;
     } else {
         PyObject *old = PySequence_GetItem(self, i); /* new ref */
         if (!old) return -1;
 
-        int rc;
-        if (orig_sq_ass_item) rc = orig_sq_ass_item(self, i, v);
-        else rc = PySequence_SetItem(self, i, v);
+        int64_t t0 = REAKTOME_STATS_START();
+        int rc = orig(self, i, v);
+        REAKTOME_STATS_OP(self, REAKTOME_OP_SETITEM, t0);
 
         if (rc < 0) { Py_DECREF(old); return -1; }
 
-        PyObject *key = PyLong_FromSsize_t(i);
-        if (key) {
-            call_hook_advisory(self, "__reaktome_setitem__", key, old, v);
-            Py_DECREF(key);
-        }
+        if (!activation_is_noop(self, old, v))
+            call_index_hook_advisory(self, REAKTOME_HOOK_SETITEM, i, old, v);
         Py_DECREF(old);
         return 0;
     }
@@ -72,6 +217,10 @@ tramp_sq_ass_item(PyObject *self, Py_ssize_t i, PyObject *v)
 static int
 tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
 {
+    objobjargproc orig = orig_mp_ass_subscript(Py_TYPE(self));
+    if (!activation_is_active(self))
+        return orig(self, key, value);
+
     /* integer index */
     if (PyIndex_Check(key)) {
         Py_ssize_t idx = PyNumber_AsSsize_t(key, PyExc_IndexError);
@@ -81,26 +230,27 @@ tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
             PyObject *old = PySequence_GetItem(self, idx);
             if (!old) return -1;
 
-            int rc = -1;
-            if (orig_mp_ass_subscript) rc = orig_mp_ass_subscript(self, key, NULL);
-            else rc = PySequence_DelItem(self, idx);
+            int64_t t0 = REAKTOME_STATS_START();
+            int rc = orig(self, key, NULL);
+            REAKTOME_STATS_OP(self, REAKTOME_OP_DELITEM, t0);
 
             if (rc < 0) { Py_DECREF(old); return -1; }
 
-            call_hook_advisory(self, "__reaktome_delitem__", key, old, NULL);
+            call_hook_advisory(self, REAKTOME_HOOK_DELITEM, key, old, NULL);
             Py_DECREF(old);
             return 0;
         } else {
             PyObject *old = PySequence_GetItem(self, idx);
             if (!old) return -1;
 
-            int rc = -1;
-            if (orig_mp_ass_subscript) rc = orig_mp_ass_subscript(self, key, value);
-            else rc = PySequence_SetItem(self, idx, value);
+            int64_t t0 = REAKTOME_STATS_START();
+            int rc = orig(self, key, value);
+            REAKTOME_STATS_OP(self, REAKTOME_OP_SETITEM, t0);
 
             if (rc < 0) { Py_DECREF(old); return -1; }
 
-            call_hook_advisory(self, "__reaktome_setitem__", key, old, value);
+            if (!activation_is_noop(self, old, value))
+                call_hook_advisory(self, REAKTOME_HOOK_SETITEM, key, old, value);
             Py_DECREF(old);
             return 0;
         }
@@ -108,142 +258,217 @@ tramp_mp_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
 
     /* slice */
     if (PySlice_Check(key)) {
+        Py_ssize_t start, stop, step;
+        if (PySlice_Unpack(key, &start, &stop, &step) < 0) return -1;
+        PySlice_AdjustIndices(PyList_GET_SIZE(self), &start, &stop, step);
+
         PyObject *old_slice = PyObject_GetItem(self, key); /* newref */
-        if (!old_slice && PyErr_Occurred()) return -1;
+        if (!old_slice) return -1;
 
-        int rc = -1;
-        if (orig_mp_ass_subscript) rc = orig_mp_ass_subscript(self, key, value);
-        else {
-            if (value == NULL) rc = PyObject_DelItem(self, key);
-            else rc = PyObject_SetItem(self, key, value);
-        }
-        if (rc < 0) { Py_XDECREF(old_slice); return -1; }
-
-        if (value && PySequence_Check(value)) {
-            Py_ssize_t n = PySequence_Size(value);
-            for (Py_ssize_t j = 0; j < n; j++) {
-                PyObject *new_item = PySequence_GetItem(value, j);
-                if (!new_item) { Py_XDECREF(old_slice); return -1; }
-                call_hook_advisory(self, "__reaktome_setitem__", NULL, NULL, new_item);
-                Py_DECREF(new_item);
-            }
-        }
+        /* materialize first: value may be an iterator, or self */
+        PyObject *new_items = value ? PySequence_List(value) : PyList_New(0);
+        if (!new_items) { Py_DECREF(old_slice); return -1; }
+
+        int64_t t0 = REAKTOME_STATS_START();
+        int rc = orig(self, key, value ? new_items : NULL);
+        REAKTOME_STATS_OP(self, REAKTOME_OP_SETSLICE, t0);
 
-        if (old_slice && PySequence_Check(old_slice)) {
-            Py_ssize_t n = PySequence_Size(old_slice);
-            for (Py_ssize_t j = 0; j < n; j++) {
-                PyObject *old_item = PySequence_GetItem(old_slice, j);
-                if (!old_item) { Py_DECREF(old_slice); return -1; }
-                call_hook_advisory(self, "__reaktome_delitem__", NULL, old_item, NULL);
-                Py_DECREF(old_item);
-            }
+        if (rc == 0) {
+            /* extended slices are not contiguous: per-item hooks only */
+            if (step == 1) report_slice(self, start, old_slice, new_items, 0);
+            else report_items(self, start, old_slice, new_items, 0);
         }
-        Py_XDECREF(old_slice);
-        return 0;
+        Py_DECREF(new_items);
+        Py_DECREF(old_slice);
+        return rc;
     }
 
-    if (value == NULL) return PyObject_DelItem(self, key);
-    return PyObject_SetItem(self, key, value);
+    return orig(self, key, value);
 }
 #else
 static int
 tramp_sq_ass_slice(PyObject *self, Py_ssize_t i, Py_ssize_t j, PyObject *v)
 {
+    if (!activation_is_active(self))
+        return orig_sq_ass_slice(Py_TYPE(self))(self, i, j, v);
+
+    Py_ssize_t n = PyList_GET_SIZE(self);
+    if (i < 0) i = 0; else if (i > n) i = n;
+
     PyObject *old_slice = PyList_GetSlice(self, i, j); /* newref */
-    if (!old_slice && PyErr_Occurred()) return -1;
+    if (!old_slice) return -1;
 
-    if (PyList_SetSlice(self, i, j, v) < 0) { Py_XDECREF(old_slice); return -1; }
+    PyObject *new_items = v ? PySequence_List(v) : PyList_New(0);
+    if (!new_items) { Py_DECREF(old_slice); return -1; }
 
-    if (v && PySequence_Check(v)) {
-        Py_ssize_t n = PySequence_Size(v);
-        for (Py_ssize_t t = 0; t < n; t++) {
-            PyObject *it = PySequence_GetItem(v, t);
-            if (!it) { Py_XDECREF(old_slice); return -1; }
-            call_hook_advisory(self, "__reaktome_setitem__", NULL, NULL, it);
-            Py_DECREF(it);
-        }
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = PyList_SetSlice(self, i, j, v ? new_items : NULL);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_SETSLICE, t0);
+
+    if (rc == 0) report_slice(self, i, old_slice, new_items, 0);
+    Py_DECREF(new_items);
+    Py_DECREF(old_slice);
+    return rc;
+}
+#endif
+
+/* sq_inplace_concat trampoline: obj += iterable, reported like extend */
+static PyObject *
+tramp_sq_inplace_concat(PyObject *self, PyObject *other)
+{
+    binaryfunc orig = orig_sq_inplace_concat(Py_TYPE(self));
+    if (!activation_is_active(self))
+        return orig(self, other);
+
+    /* materialize first: other may be an iterator, or self */
+    PyObject *items = PySequence_List(other);
+    if (!items) return NULL;
+
+    Py_ssize_t idx = PyList_GET_SIZE(self);
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *res = orig(self, items);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_IADD, t0);
+
+    if (res) report_slice(self, idx, NULL, items, 1);
+    Py_DECREF(items);
+    return res;
+}
+
+/* sq_inplace_repeat trampoline: obj *= count. One __reaktome_repeat__
+   call with the count when registered; otherwise the added copies (or, for
+   count <= 0, the removed items) are reported like a slice assignment. */
+static PyObject *
+tramp_sq_inplace_repeat(PyObject *self, Py_ssize_t count)
+{
+    ssizeargfunc orig = orig_sq_inplace_repeat(Py_TYPE(self));
+    if (!activation_is_active(self))
+        return orig(self, count);
+
+    Py_ssize_t n = PyList_GET_SIZE(self);
+    int changes = n > 0 && count != 1;
+    int compact = activation_has_hook(self, REAKTOME_HOOK_REPEAT);
+
+    PyObject *before = NULL;
+    if (changes && !compact && count <= 0) {
+        before = PyList_GetSlice(self, 0, n);
+        if (!before) return NULL;
+    }
+
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *res = orig(self, count);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_IMUL, t0);
+    if (!res || !changes) {
+        Py_XDECREF(before);
+        return res;
     }
-    if (old_slice && PySequence_Check(old_slice)) {
-        Py_ssize_t n = PySequence_Size(old_slice);
-        for (Py_ssize_t t = 0; t < n; t++) {
-            PyObject *it = PySequence_GetItem(old_slice, t);
-            if (!it) { Py_DECREF(old_slice); return -1; }
-            call_hook_advisory(self, "__reaktome_delitem__", NULL, it, NULL);
-            Py_DECREF(it);
+
+    if (compact) {
+        PyObject *key = PyLong_FromSsize_t(count);
+        if (key) {
+            call_hook_advisory(self, REAKTOME_HOOK_REPEAT, key, NULL, NULL);
+            Py_DECREF(key);
+        } else {
+            PyErr_Clear();
         }
+    } else if (before) {
+        PyObject *none = PyList_New(0);
+        if (none) report_slice(self, 0, before, none, 1);
+        else PyErr_Clear();
+        Py_XDECREF(none);
+        Py_DECREF(before);
+    } else {
+        PyObject *added = PyList_GetSlice(self, n, PyList_GET_SIZE(self));
+        if (added) report_slice(self, n, NULL, added, 1);
+        else PyErr_Clear();
+        Py_XDECREF(added);
     }
-    Py_XDECREF(old_slice);
-    return 0;
+    return res;
 }
-#endif
 
 /* ---------- method trampolines using the C-API ---------- */
 
 static PyObject *
 tramp_append(PyObject *self, PyObject *arg)
 {
-    fprintf(stderr, "Reaktome tramp_append()\n");
+    if (!activation_is_active(self)) {
+        PyObject *orig = orig_method(Py_TYPE(self), W_APPEND);
+        if (!orig) return NULL;
+        PyObject *stack[2] = {self, arg};
+        return PyObject_Vectorcall(orig, stack, 2, NULL);
+    }
 
     Py_ssize_t idx = PyList_GET_SIZE(self);
 
-    if (PyList_Append(self, arg) < 0) return NULL;
-
-    PyObject *key = PyLong_FromSsize_t(idx);
-    if (!key)
-        return NULL;
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = PyList_Append(self, arg);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_APPEND, t0);
+    if (rc < 0) return NULL;
 
-    if (reaktome_call_dunder(self, "__reaktome_setitem__", key, NULL, arg) < 0) {
-        Py_DECREF(key);
+    if (reaktome_call_hook_index(self, REAKTOME_HOOK_SETITEM, idx, NULL, arg) < 0)
         return NULL;
-    }
-
-    Py_DECREF(key);
     Py_RETURN_NONE;
 }
 
 static PyObject *
 tramp_extend(PyObject *self, PyObject *iterable)
 {
-    fprintf(stderr, "Reaktome tramp_extend()\n");
+    if (!activation_is_active(self)) {
+        PyObject *orig = orig_method(Py_TYPE(self), W_EXTEND);
+        if (!orig) return NULL;
+        PyObject *stack[2] = {self, iterable};
+        return PyObject_Vectorcall(orig, stack, 2, NULL);
+    }
 
+    /* materialize first: iterable may be an iterator, or self */
+    PyObject *items = PySequence_List(iterable);
+    if (!items) return NULL;
+
+    /* one resize and copy, then the hooks */
     Py_ssize_t idx = PyList_GET_SIZE(self);
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = PyList_SetSlice(self, idx, idx, items);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_EXTEND, t0);
+    if (rc < 0) { Py_DECREF(items); return NULL; }
 
-    PyObject *it = PyObject_GetIter(iterable);
-    if (!it) return NULL;
-    PyObject *item;
-    PyObject *key;
-    while ((item = PyIter_Next(it))) {
-        key = PyLong_FromSsize_t(idx++);
-        if (PyList_Append(self, item) < 0) { Py_DECREF(item); Py_DECREF(it); return NULL; }
-        call_hook_advisory(self, "__reaktome_setitem__", key, NULL, item);
-        Py_DECREF(key);
-        Py_DECREF(item);
-    }
-    Py_DECREF(it);
-    if (PyErr_Occurred()) return NULL;
+    report_slice(self, idx, NULL, items, 1);
+    Py_DECREF(items);
     Py_RETURN_NONE;
 }
 
 static PyObject *
-tramp_insert(PyObject *self, PyObject *args)
+tramp_insert(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
-    Py_ssize_t idx;
-    PyObject *val;
-    if (!PyArg_ParseTuple(args, "nO:insert", &idx, &val)) return NULL;
-    if (PyList_Insert(self, idx, val) < 0) return NULL;
-    PyObject *key = PyLong_FromSsize_t(idx);
-    if (key) {
-        call_hook_advisory(self, "__reaktome_setitem__", key, NULL, val);
-        Py_DECREF(key);
+    if (!activation_is_active(self)) {
+        PyObject *orig = orig_method(Py_TYPE(self), W_INSERT);
+        return orig ? reaktome_call_orig(orig, self, args, nargs, NULL) : NULL;
     }
+
+    if (!reaktome_check_nargs("insert", nargs, 2, 2)) return NULL;
+    Py_ssize_t idx = PyNumber_AsSsize_t(args[0], PyExc_OverflowError);
+    if (idx == -1 && PyErr_Occurred()) return NULL;
+    PyObject *val = args[1];
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = PyList_Insert(self, idx, val);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_INSERT, t0);
+    if (rc < 0) return NULL;
+    call_index_hook_advisory(self, REAKTOME_HOOK_SETITEM, idx, NULL, val);
     Py_RETURN_NONE;
 }
 
 static PyObject *
-tramp_pop(PyObject *self, PyObject *args)
+tramp_pop(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
+    if (!activation_is_active(self)) {
+        PyObject *orig = orig_method(Py_TYPE(self), W_POP);
+        return orig ? reaktome_call_orig(orig, self, args, nargs, NULL) : NULL;
+    }
+
+    if (!reaktome_check_nargs("pop", nargs, 0, 1)) return NULL;
     Py_ssize_t idx = -1;
-    if (!PyArg_ParseTuple(args, "|n:pop", &idx)) return NULL;
+    if (nargs) {
+        idx = PyNumber_AsSsize_t(args[0], PyExc_OverflowError);
+        if (idx == -1 && PyErr_Occurred()) return NULL;
+    }
     Py_ssize_t n = PyList_GET_SIZE(self);
     if (n == 0) { PyErr_SetString(PyExc_IndexError, "pop from empty list"); return NULL; }
     if (idx == -1) idx = n - 1;
@@ -253,23 +478,26 @@ tramp_pop(PyObject *self, PyObject *args)
     PyObject *old = PySequence_GetItem(self, idx);
     if (!old) return NULL;
 
-    int rc;
-    if (orig_sq_ass_item) rc = orig_sq_ass_item(self, idx, NULL);
-    else rc = PyList_SetSlice(self, idx, idx+1, NULL);
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = orig_sq_ass_item(Py_TYPE(self))(self, idx, NULL);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_POP, t0);
 
     if (rc < 0) { Py_DECREF(old); return NULL; }
 
-    PyObject *key = PyLong_FromSsize_t(idx);
-    if (key) {
-        call_hook_advisory(self, "__reaktome_delitem__", key, old, NULL);
-        Py_DECREF(key);
-    }
+    call_index_hook_advisory(self, REAKTOME_HOOK_DELITEM, idx, old, NULL);
     return old; /* newref */
 }
 
 static PyObject *
 tramp_remove(PyObject *self, PyObject *arg)
 {
+    if (!activation_is_active(self)) {
+        PyObject *orig = orig_method(Py_TYPE(self), W_REMOVE);
+        if (!orig) return NULL;
+        PyObject *stack[2] = {self, arg};
+        return PyObject_Vectorcall(orig, stack, 2, NULL);
+    }
+
     Py_ssize_t n = PyList_GET_SIZE(self);
     for (Py_ssize_t i = 0; i < n; i++) {
         PyObject *it = PyList_GET_ITEM(self, i); /* borrowed */
@@ -277,15 +505,11 @@ tramp_remove(PyObject *self, PyObject *arg)
         if (eq < 0) return NULL;
         if (eq > 0) {
             PyObject *old = Py_NewRef(it);
-            int rc;
-            if (orig_sq_ass_item) rc = orig_sq_ass_item(self, i, NULL);
-            else rc = PySequence_DelItem(self, i);
+            int64_t t0 = REAKTOME_STATS_START();
+            int rc = orig_sq_ass_item(Py_TYPE(self))(self, i, NULL);
+            REAKTOME_STATS_OP(self, REAKTOME_OP_REMOVE, t0);
             if (rc < 0) { Py_DECREF(old); return NULL; }
-            PyObject *key = PyLong_FromSsize_t(i);
-            if (key) {
-                call_hook_advisory(self, "__reaktome_delitem__", key, old, NULL);
-                Py_DECREF(key);
-            }
+            call_index_hook_advisory(self, REAKTOME_HOOK_DELITEM, i, old, NULL);
             Py_DECREF(old);
             Py_RETURN_NONE;
         }
@@ -294,117 +518,614 @@ tramp_remove(PyObject *self, PyObject *arg)
     return NULL;
 }
 
+/* Move self's items into a new list and leave self empty, as list.clear
+   does but without releasing them: no copy and no refcount traffic. */
+static PyObject *
+detach_items(PyObject *self)
+{
+    PyObject *detached = PyList_New(0);
+    if (!detached) return NULL;
+    PyListObject *from = (PyListObject *)self, *to = (PyListObject *)detached;
+    to->ob_item = from->ob_item;
+    to->allocated = from->allocated;
+    Py_SET_SIZE(to, Py_SIZE(from));
+    from->ob_item = NULL;
+    from->allocated = 0;
+    Py_SET_SIZE(from, 0);
+    return detached;
+}
+
+/* clear(): detach the items, then one __reaktome_clear__(self, None,
+   old_items, None) call, or a delitem per old index without it. The items
+   are released only after the hooks ran. */
 static PyObject *
 tramp_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
 {
+    if (!activation_is_active(self)) {
+        PyObject *orig = orig_method(Py_TYPE(self), W_CLEAR);
+        return orig ? PyObject_Vectorcall(orig, &self, 1, NULL) : NULL;
+    }
+
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *old = detach_items(self);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_CLEAR, t0);
+    if (!old) return NULL;
+
+    Py_ssize_t n = PyList_GET_SIZE(old);
+    if (n && activation_has_hook(self, REAKTOME_HOOK_CLEAR)) {
+        call_hook_advisory(self, REAKTOME_HOOK_CLEAR, NULL, old, NULL);
+    } else {
+        for (Py_ssize_t i = 0; i < n; i++)
+            call_index_hook_advisory(self, REAKTOME_HOOK_DELITEM, i,
+                                     PyList_GET_ITEM(old, i), NULL);
+    }
+    Py_DECREF(old);
+    Py_RETURN_NONE;
+}
+
+/* sort(*, key=None, reverse=False): one __reaktome_reorder__(self, "sort",
+   None, perm) call. Permutations have no per-item equivalent (setitem /
+   delitem would deactivate items that are still present), so instances
+   without the hook are not notified. */
+static PyObject *
+tramp_sort(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *orig = orig_method(Py_TYPE(self), W_SORT);
+    if (!orig) return NULL;
+    if (!activation_is_active(self))
+        return reaktome_call_orig(orig, self, args, nargs, kwnames);
+
     Py_ssize_t n = PyList_GET_SIZE(self);
-    for (Py_ssize_t i = 0; i < n; i++) {
-        PyObject *old = Py_NewRef(PyList_GET_ITEM(self, i));
-        PyObject *key = PyLong_FromSsize_t(i);
-        if (key) {
-            call_hook_advisory(self, "__reaktome_delitem__", key, old, NULL);
-            Py_DECREF(key);
+    int report = n > 1 && activation_has_hook(self, REAKTOME_HOOK_REORDER);
+    PyObject *before = NULL;
+    if (report) {
+        before = PyList_GetSlice(self, 0, n);
+        if (!before) return NULL;
+    }
+
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *res = reaktome_call_orig(orig, self, args, nargs, kwnames);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_SORT, t0);
+    if (!report) return res;
+
+    /* a sort that raised (e.g. in a key function) may still have moved items */
+    PyObject *exc = PyErr_GetRaisedException();
+    PyObject *perm = sort_permutation(self, before);
+    if (perm) {
+        PyObject *kind = PyUnicode_FromString("sort");
+        if (kind) {
+            call_hook_advisory(self, REAKTOME_HOOK_REORDER, kind, NULL, perm);
+            Py_DECREF(kind);
+        } else {
+            PyErr_Clear();
         }
-        Py_DECREF(old);
+        Py_DECREF(perm);
     }
-    if (PyList_SetSlice(self, 0, n, NULL) < 0) return NULL;
-    Py_RETURN_NONE;
+    PyErr_SetRaisedException(exc);
+    Py_DECREF(before);
+    return res;
+}
+
+/* reverse(): one __reaktome_reorder__(self, "reverse", None, None) call. */
+static PyObject *
+tramp_reverse(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *orig = orig_method(Py_TYPE(self), W_REVERSE);
+    if (!orig) return NULL;
+    if (!activation_is_active(self))
+        return PyObject_Vectorcall(orig, &self, 1, NULL);
+
+    Py_ssize_t n = PyList_GET_SIZE(self);
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *res = PyObject_Vectorcall(orig, &self, 1, NULL);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_REVERSE, t0);
+    if (!res || n < 2) return res;
+
+    PyObject *kind = PyUnicode_FromString("reverse");
+    if (kind) {
+        call_hook_advisory(self, REAKTOME_HOOK_REORDER, kind, NULL, NULL);
+        Py_DECREF(kind);
+    } else {
+        PyErr_Clear();
+    }
+    return res;
 }
 
 /* ---------- static PyMethodDef objects (file scope) ---------- */
 static PyMethodDef append_def  = {"append",  (PyCFunction)tramp_append,  METH_O,       "append (trampoline)"};
 static PyMethodDef extend_def  = {"extend",  (PyCFunction)tramp_extend,  METH_O,       "extend (trampoline)"};
-static PyMethodDef insert_def  = {"insert",  (PyCFunction)tramp_insert,  METH_VARARGS, "insert (trampoline)"};
-static PyMethodDef pop_def     = {"pop",     (PyCFunction)tramp_pop,     METH_VARARGS, "pop (trampoline)"};
+static PyMethodDef insert_def  = {"insert",  (PyCFunction)(void(*)(void))tramp_insert, METH_FASTCALL, "insert (trampoline)"};
+static PyMethodDef pop_def     = {"pop",     (PyCFunction)(void(*)(void))tramp_pop,    METH_FASTCALL, "pop (trampoline)"};
 static PyMethodDef remove_def  = {"remove",  (PyCFunction)tramp_remove,  METH_O,       "remove (trampoline)"};
 static PyMethodDef clear_def   = {"clear",   (PyCFunction)tramp_clear,   METH_NOARGS,  "clear (trampoline)"};
+static PyMethodDef sort_def    = {"sort",    (PyCFunction)(void(*)(void))tramp_sort, METH_FASTCALL | METH_KEYWORDS, "sort (trampoline)"};
+static PyMethodDef reverse_def = {"reverse", (PyCFunction)tramp_reverse, METH_NOARGS,  "reverse (trampoline)"};
+
+/* ---------- installation state ---------- */
+
+#define HOOK(h) REAKTOME_HOOK_BIT(REAKTOME_HOOK_##h)
+
+/* Method wrappers shadowed in a patched type's dict, each with the hooks
+   it can fire: a wrapper is installed once some activation registers one. */
+static const struct {
+    const char *name;
+    PyMethodDef *def;
+    unsigned int hooks;
+} list_wrappers[N_SHADOWED] = {
+    [W_APPEND]  = {"append",  &append_def,  HOOK(SETITEM)},
+    [W_EXTEND]  = {"extend",  &extend_def,  HOOK(SETITEM) | HOOK(SETSLICE)},
+    [W_INSERT]  = {"insert",  &insert_def,  HOOK(SETITEM)},
+    [W_POP]     = {"pop",     &pop_def,     HOOK(DELITEM)},
+    [W_REMOVE]  = {"remove",  &remove_def,  HOOK(DELITEM)},
+    [W_CLEAR]   = {"clear",   &clear_def,   HOOK(CLEAR) | HOOK(DELITEM)},
+    [W_SORT]    = {"sort",    &sort_def,    HOOK(REORDER)},
+    [W_REVERSE] = {"reverse", &reverse_def, HOOK(REORDER)},
+};
+
+/* Interned list_wrappers names (module init) */
+static PyObject *wrapper_names[N_SHADOWED];
+
+/* Slot trampolines, as bits of list_install.slots, and the hooks they fire. */
+enum {
+    SLOT_ASS_ITEM       = 1u << 0,   /* sq_ass_item */
+    SLOT_INPLACE_CONCAT = 1u << 1,   /* sq_inplace_concat (+=) */
+    SLOT_INPLACE_REPEAT = 1u << 2,   /* sq_inplace_repeat (*=) */
+    SLOT_ASS_SUBSCRIPT  = 1u << 3,   /* mp_ass_subscript (sq_ass_slice before 3.9) */
+};
+#define ASS_ITEM_HOOKS       (HOOK(SETITEM) | HOOK(DELITEM))
+#define INPLACE_CONCAT_HOOKS (HOOK(SETITEM) | HOOK(SETSLICE))
+#define INPLACE_REPEAT_HOOKS (HOOK(REPEAT) | HOOK(SETITEM) | HOOK(DELITEM) | HOOK(SETSLICE))
+#define ASS_SUBSCRIPT_HOOKS  (HOOK(SETITEM) | HOOK(DELITEM) | HOOK(SETSLICE))
+#define ALL_SLOTS (SLOT_ASS_ITEM | SLOT_INPLACE_CONCAT | SLOT_INPLACE_REPEAT | SLOT_ASS_SUBSCRIPT)
+
+/* What is installed on one type (bits of `slots` / one bit per
+   list_wrappers entry in `methods`), the originals it replaced, and the
+   entries the type's own dict held before shadowing (NULL = was
+   inherited). Slots belong to the type's own install; a wrapper in its
+   dict is shared by every install in `users[i]`, and `target[i]` is the
+   type holding the wrapper this type's install relies on. */
+typedef struct {
+    unsigned int slots;
+    unsigned int methods;
+    ssizeobjargproc sq_ass_item;
+    binaryfunc sq_inplace_concat;
+    ssizeargfunc sq_inplace_repeat;
+#if PY_VERSION_HEX >= 0x03090000
+    objobjargproc mp_ass_subscript;
+#else
+    ssizessizeobjargproc sq_ass_slice;
+#endif
+    PyObject *orig_methods[N_SHADOWED];
+    PyObject *own[N_SHADOWED];
+    Py_ssize_t users[N_SHADOWED];
+    PyTypeObject *target[N_SHADOWED];
+} list_install;
+
+/* PyTypeObject* -> list_install*, for each patched type and ReaktomeList */
+static ptr_table list_installs;
 
-/* ---------- helper: ensure trampolines installed once per type ---------- */
+static inline list_install *
+install_find(PyTypeObject *tp)
+{
+    ptr_entry *e = ptr_table_find(&list_installs, tp);
+    return e ? (list_install *)e->value : NULL;
+}
+
+/* The original behind a slot trampoline for instances of tp: saved by the
+   nearest type along the MRO that installed it, else the first slot there
+   that is not the trampoline (inherited after its owner was uninstalled).
+   The walk starts at the first type whose slot is the trampoline: types
+   above it override the slot in Python (a ReaktomeList subclass with its
+   own __setitem__) and reach the trampoline through super(), so their
+   slot_* would recurse. list is always in the MRO, so this finds one. */
+#define DEFINE_ORIG_SLOT(type, table, slot, bit)                             \
+    static type                                                              \
+    orig_##slot(PyTypeObject *tp)                                            \
+    {                                                                        \
+        PyObject *mro = tp->tp_mro;                                          \
+        Py_ssize_t k = 0;                                                    \
+        while (k < PyTuple_GET_SIZE(mro)) {                                  \
+            PyTypeObject *base = (PyTypeObject *)PyTuple_GET_ITEM(mro, k);   \
+            if (base->table && base->table->slot == tramp_##slot) break;     \
+            k++;                                                             \
+        }                                                                    \
+        if (k == PyTuple_GET_SIZE(mro)) k = 0;                               \
+        for (; k < PyTuple_GET_SIZE(mro); k++) {                             \
+            PyTypeObject *base = (PyTypeObject *)PyTuple_GET_ITEM(mro, k);   \
+            list_install *in = install_find(base);                           \
+            if (in && (in->slots & SLOT_##bit)) return in->slot;             \
+            if (base->table && base->table->slot &&                          \
+                base->table->slot != tramp_##slot)                           \
+                return base->table->slot;                                    \
+        }                                                                    \
+        return NULL;                                                         \
+    }
+
+DEFINE_ORIG_SLOT(ssizeobjargproc, tp_as_sequence, sq_ass_item, ASS_ITEM)
+DEFINE_ORIG_SLOT(binaryfunc, tp_as_sequence, sq_inplace_concat, INPLACE_CONCAT)
+DEFINE_ORIG_SLOT(ssizeargfunc, tp_as_sequence, sq_inplace_repeat, INPLACE_REPEAT)
+#if PY_VERSION_HEX >= 0x03090000
+DEFINE_ORIG_SLOT(objobjargproc, tp_as_mapping, mp_ass_subscript, ASS_SUBSCRIPT)
+#else
+DEFINE_ORIG_SLOT(ssizessizeobjargproc, tp_as_sequence, sq_ass_slice, ASS_SUBSCRIPT)
+#endif
 
+#undef DEFINE_ORIG_SLOT
+
+/* A type's own entry for a wrapper name that is not a method descriptor
+   (list's own, another C type's, or a wrapper) is a subclass override.
+   Wrappers never shadow one; they sit below it in the MRO instead. */
+static inline int
+is_override(PyObject *own)
+{
+    return own && !Py_IS_TYPE(own, &PyMethodDescr_Type);
+}
+
+/* Same for the method wrapper `which`: the nearest saved original along
+   the MRO, else the first entry there that is not an override (an
+   override reaches the wrapper only through super(), so forwarding to it
+   would recurse). Borrowed; NULL with an exception on error. */
+static PyObject *
+orig_method(PyTypeObject *tp, int which)
+{
+    PyObject *mro = tp->tp_mro;
+    for (Py_ssize_t k = 0; k < PyTuple_GET_SIZE(mro); k++) {
+        PyTypeObject *base = (PyTypeObject *)PyTuple_GET_ITEM(mro, k);
+        list_install *in = install_find(base);
+        if (in && (in->methods & (1u << which))) return in->orig_methods[which];
+
+        PyObject *dict = PyType_GetDict(base); /* newref */
+        if (!dict) return NULL;
+        PyObject *own = PyDict_GetItemWithError(dict, wrapper_names[which]);
+        Py_DECREF(dict); /* the type keeps it, and own, alive */
+        if (!own && PyErr_Occurred()) return NULL;
+        if (own && !is_override(own)) return own;
+    }
+    PyErr_Format(PyExc_SystemError, "no original list.%s", list_wrappers[which].name);
+    return NULL;
+}
+
+/* Where instances of tp need the wrapper `which`: tp itself, unless its
+   MRO overrides the method, in which case the type right after the last
+   override, so the override's super() call lands on the wrapper. That is
+   list itself when tp derives from it directly. Borrowed. */
+static PyTypeObject *
+method_target(PyTypeObject *tp, int which)
+{
+    PyObject *mro = tp->tp_mro;
+    PyTypeObject *target = tp;
+    for (Py_ssize_t k = 0; k + 1 < PyTuple_GET_SIZE(mro); k++) {
+        PyTypeObject *base = (PyTypeObject *)PyTuple_GET_ITEM(mro, k);
+        list_install *in = install_find(base);
+        if (in && (in->methods & (1u << which))) break;
+
+        PyObject *dict = PyType_GetDict(base); /* newref */
+        if (!dict) return NULL;
+        PyObject *own = PyDict_GetItemWithError(dict, wrapper_names[which]);
+        Py_DECREF(dict);
+        if (!own && PyErr_Occurred()) return NULL;
+        if (!own) continue;
+        if (!is_override(own)) break;
+        target = (PyTypeObject *)PyTuple_GET_ITEM(mro, k + 1);
+    }
+    return target;
+}
+
+static list_install *
+install_ensure(PyTypeObject *tp)
+{
+    list_install *in = install_find(tp);
+    if (in) return in;
+    in = PyMem_Calloc(1, sizeof(list_install));
+    if (!in) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if (!ptr_table_insert(&list_installs, tp, in)) {
+        PyMem_Free(in);
+        return NULL;
+    }
+    return in;
+}
+
+/* Free tp's record once neither its own install nor any wrapper user
+   needs it */
+static void
+install_drop_if_empty(PyTypeObject *tp)
+{
+    list_install *in = install_find(tp);
+    if (!in || in->slots || in->methods) return;
+    for (int i = 0; i < N_SHADOWED; i++)
+        if (in->target[i]) return;
+    PyMem_Free(ptr_table_pop(&list_installs, tp));
+}
+
+/* Shadow wrapper `which` in tp's dict, or share the one already there:
+   save the original method object (possibly inherited) and tp's own
+   entry, then install */
 static int
-ensure_list_type_patched(PyTypeObject *tp)
+acquire_method(PyTypeObject *tp, int which)
 {
-    static int already_patched = 0;
+    /* a static type's wrappers outlive their users; its own install
+       (held by nobody, so kept until unpatch_all) removes them */
+    if (!(tp->tp_flags & Py_TPFLAGS_HEAPTYPE) &&
+        activation_install(tp, uninstall_list_type) < 0) return -1;
+    list_install *in = install_ensure(tp);
+    if (!in) return -1;
+    if (in->methods & (1u << which)) {
+        in->users[which]++;
+        return 0;
+    }
 
-    if (!tp) {
-        fprintf(stderr, "ensure_list_type_patched: NULL type\n");
-        PyErr_SetString(PyExc_SystemError, "ensure_list_type_patched: NULL type");
+    PyObject *dict = PyType_GetDict(tp); /* newref */
+    if (!dict) return -1;
+    PyObject *orig = orig_method(tp, which); /* borrowed */
+    PyObject *own = orig ? PyDict_GetItemWithError(dict, wrapper_names[which]) : NULL;
+    if (!orig || (!own && PyErr_Occurred())) {
+        Py_DECREF(dict);
+        install_drop_if_empty(tp);
         return -1;
     }
-
-    /* Ensure the type is initialized */
-    if (PyType_Ready(tp) < 0) {
+    orig = Py_NewRef(orig);
+    own = Py_XNewRef(own);
+
+    PyObject *func = PyDescr_NewMethod(tp, list_wrappers[which].def);
+    if (!func || PyDict_SetItem(dict, wrapper_names[which], func) < 0) {
+        Py_XDECREF(func);
+        Py_DECREF(dict);
+        Py_DECREF(orig);
+        Py_XDECREF(own);
+        install_drop_if_empty(tp);
         return -1;
     }
+    Py_DECREF(func); /* dict owns the ref */
+    Py_DECREF(dict);
+    in->orig_methods[which] = orig;
+    in->own[which] = own;
+    in->users[which] = 1;
+    in->methods |= 1u << which;
+    PyType_Modified(tp);
+    return 0;
+}
 
-    /* If we've already patched, just ensure original slots are saved */
-    if (already_patched) {
-        PySequenceMethods *sq = tp->tp_as_sequence;
-        if (sq && orig_sq_ass_item == NULL) orig_sq_ass_item = sq->sq_ass_item;
-#if PY_VERSION_HEX < 0x03090000
-        if (sq && orig_sq_ass_slice == NULL) orig_sq_ass_slice = sq->sq_ass_slice;
-#endif
+/* Put tp's own entry for wrapper `which` back */
+static void
+restore_method(PyTypeObject *tp, list_install *in, int which)
+{
+    PyObject *own = in->own[which];
+    PyObject *dict = PyType_GetDict(tp); /* newref */
+    if (dict) {
+        int rc = own ? PyDict_SetItem(dict, wrapper_names[which], own)
+                     : PyDict_DelItem(dict, wrapper_names[which]);
+        if (rc < 0) PyErr_Clear();
+        Py_DECREF(dict);
+    }
+    else {
+        PyErr_Clear();
+    }
+    Py_XDECREF(own);
+    Py_DECREF(in->orig_methods[which]);
+    in->own[which] = in->orig_methods[which] = NULL;
+    in->users[which] = 0;
+    in->methods &= ~(1u << which);
+    PyType_Modified(tp);
+    install_drop_if_empty(tp);
+}
+
+/* Drop one user of wrapper `which` in tp's dict; the last one restores
+   tp's own entry. A static type (list) keeps the wrapper until its own
+   uninstall, which only unpatch_all() runs (see activation.c). */
+static void
+release_method(PyTypeObject *tp, int which)
+{
+    list_install *in = install_find(tp);
+    if (!in || !(in->methods & (1u << which)) || --in->users[which] > 0)
+        return;
+    if (!(tp->tp_flags & Py_TPFLAGS_HEAPTYPE)) return;
+    restore_method(tp, in, which);
+}
+
+/* Undo ensure_list_type_patched on tp once its last activated instance is
+   gone. Subclasses created in the meantime inherited the trampolines;
+   those now find tp's restored slots. */
+static void
+uninstall_list_type(PyTypeObject *tp)
+{
+    list_install *in = install_find(tp);
+    if (!in) return;
+
+    PySequenceMethods *sq = tp->tp_as_sequence;
+    if ((in->slots & SLOT_ASS_ITEM) && sq->sq_ass_item == tramp_sq_ass_item)
+        sq->sq_ass_item = in->sq_ass_item;
+    if ((in->slots & SLOT_INPLACE_CONCAT) && sq->sq_inplace_concat == tramp_sq_inplace_concat)
+        sq->sq_inplace_concat = in->sq_inplace_concat;
+    if ((in->slots & SLOT_INPLACE_REPEAT) && sq->sq_inplace_repeat == tramp_sq_inplace_repeat)
+        sq->sq_inplace_repeat = in->sq_inplace_repeat;
 #if PY_VERSION_HEX >= 0x03090000
-        PyMappingMethods *mp = tp->tp_as_mapping;
-        if (mp && orig_mp_ass_subscript == NULL) orig_mp_ass_subscript = mp->mp_ass_subscript;
+    PyMappingMethods *mp = tp->tp_as_mapping;
+    if ((in->slots & SLOT_ASS_SUBSCRIPT) && mp->mp_ass_subscript == tramp_mp_ass_subscript)
+        mp->mp_ass_subscript = in->mp_ass_subscript;
+#else
+    if ((in->slots & SLOT_ASS_SUBSCRIPT) && sq->sq_ass_slice == tramp_sq_ass_slice)
+        sq->sq_ass_slice = in->sq_ass_slice;
 #endif
-        return 0;
+    in->slots = 0;
+
+    /* Releasing may free `in` (tp can be its own target) */
+    PyTypeObject *targets[N_SHADOWED];
+    for (int i = 0; i < N_SHADOWED; i++) {
+        targets[i] = in->target[i];
+        in->target[i] = NULL;
+    }
+    for (int i = 0; i < N_SHADOWED; i++)
+        if (targets[i]) release_method(targets[i], i);
+
+    /* a static type's wrappers go too, whoever still counts on them:
+       this is unpatch_all(), which uninstalls those users as well */
+    if (!(tp->tp_flags & Py_TPFLAGS_HEAPTYPE)) {
+        for (int i = 0; i < N_SHADOWED; i++) {
+            in = install_find(tp);
+            if (in && (in->methods & (1u << i))) restore_method(tp, in, i);
+        }
     }
 
-    /* Get the type dict (borrowed) */
-    PyObject *dict = PyType_GetDict(tp);  /* borrowed */
-    if (dict == NULL) {
-        /* Defensive: this should not happen after PyType_Ready for builtins, but check */
-        fprintf(stderr, "ensure_list_type_patched: PyType_GetDict returned NULL for %p\n", (void*)tp);
-        PyErr_SetString(PyExc_RuntimeError, "list type has no tp_dict after PyType_Ready");
-        return -1;
+    install_drop_if_empty(tp);
+    PyType_Modified(tp);
+}
+
+/* ---------- helper: install what `hooks` need on a list type ----------
+   tp is the concrete type of the patched instance; list itself only when
+   a plain list is observed. */
+
+static int
+ensure_list_type_patched(PyTypeObject *tp, unsigned int hooks)
+{
+    if (PyType_Ready(tp) < 0) return -1;
+
+    /* Evict side-table entries when instances of tp die */
+    if (activation_evict_on_dealloc(tp) < 0) return -1;
+
+    /* Every activation of tp's instances holds this install */
+    if (activation_install(tp, uninstall_list_type) < 0) return -1;
+    list_install *in = install_ensure(tp);
+    if (!in) return -1;
+
+    /* Wrappers these hooks need, on tp or below its overrides */
+    for (int i = 0; i < N_SHADOWED; i++) {
+        if (!(list_wrappers[i].hooks & hooks) || in->target[i])
+            continue;
+        PyTypeObject *target = method_target(tp, i);
+        if (!target || acquire_method(target, i) < 0) return -1;
+        in->target[i] = target;
     }
 
-    /* Install method descriptors into type dict */
-    #define INSTALL_DEF_IN_DICT(defptr, name_lit)                             \
+    /* Save the original slot pointers, then install our trampolines */
+    #define INSTALL_SLOT(bit, table, slot)                                    \
         do {                                                                  \
-            PyObject *func = (PyObject *)PyDescr_NewMethod(tp, (defptr));     \
-            if (!func) return -1;                                             \
-            if (PyDict_SetItemString(dict, (name_lit), func) < 0) {           \
-                Py_DECREF(func);                                              \
-                return -1;                                                    \
+            if ((table) && (hooks & bit##_HOOKS) && !(in->slots & SLOT_##bit)) { \
+                in->slot = orig_##slot(tp);                                   \
+                (table)->slot = tramp_##slot;                                 \
+                in->slots |= SLOT_##bit;                                      \
             }                                                                 \
-            Py_DECREF(func); /* dict owns the ref */                          \
         } while (0)
 
-    INSTALL_DEF_IN_DICT(&append_def,  "append");
-    INSTALL_DEF_IN_DICT(&extend_def,  "extend");
-    INSTALL_DEF_IN_DICT(&insert_def,  "insert");
-    INSTALL_DEF_IN_DICT(&pop_def,     "pop");
-    INSTALL_DEF_IN_DICT(&remove_def,  "remove");
-    INSTALL_DEF_IN_DICT(&clear_def,   "clear");
+    PySequenceMethods *sq = tp->tp_as_sequence;
+    INSTALL_SLOT(ASS_ITEM, sq, sq_ass_item);
+    INSTALL_SLOT(INPLACE_CONCAT, sq, sq_inplace_concat);
+    INSTALL_SLOT(INPLACE_REPEAT, sq, sq_inplace_repeat);
+#if PY_VERSION_HEX >= 0x03090000
+    PyMappingMethods *mp = tp->tp_as_mapping;
+    INSTALL_SLOT(ASS_SUBSCRIPT, mp, mp_ass_subscript);
+#else
+    INSTALL_SLOT(ASS_SUBSCRIPT, sq, sq_ass_slice);
+#endif
+
+    #undef INSTALL_SLOT
+
+    PyType_Modified(tp);
+    return 0;
+}
+
+/* ---------- native subclass: ReaktomeList ----------
+   A list subclass whose slots and methods are the trampolines above and
+   whose activation entry lives in the object. Nothing global is patched
+   for it, and observed instances never probe the side-table. Its
+   permanent install forwards to PyList_Type's own slots and methods
+   (see native_list_init). */
 
-    #undef INSTALL_DEF_IN_DICT
+typedef struct {
+    PyListObject list;
+    reaktome_entry entry;
+} reaktome_list;
 
-    /* Save original slot pointers then install our trampolines. */
-    PySequenceMethods *sq = tp->tp_as_sequence;
-    if (sq) {
-        orig_sq_ass_item = sq->sq_ass_item;
-        sq->sq_ass_item = tramp_sq_ass_item;
+static void
+native_list_dealloc(PyObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    activation_merge(self, Py_None);
+    PyList_Type.tp_dealloc(self);
+}
+
+static int
+native_list_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(((reaktome_list *)self)->entry.hooks.dunders);
+    return PyList_Type.tp_traverse(self, visit, arg);
+}
+
+static int
+native_list_clear(PyObject *self)
+{
+    activation_merge(self, Py_None);
+    return PyList_Type.tp_clear(self);
+}
+
+static PySequenceMethods native_list_as_sequence = {
+    .sq_ass_item = tramp_sq_ass_item,
+    .sq_inplace_concat = tramp_sq_inplace_concat,
+    .sq_inplace_repeat = tramp_sq_inplace_repeat,
 #if PY_VERSION_HEX < 0x03090000
-        orig_sq_ass_slice = sq->sq_ass_slice;
-        sq->sq_ass_slice = tramp_sq_ass_slice;
+    .sq_ass_slice = tramp_sq_ass_slice,
 #endif
-    }
+};
 
 #if PY_VERSION_HEX >= 0x03090000
-    PyMappingMethods *mp = tp->tp_as_mapping;
-    if (mp) {
-        orig_mp_ass_subscript = mp->mp_ass_subscript;
-        mp->mp_ass_subscript = tramp_mp_ass_subscript;
-    }
+static PyMappingMethods native_list_as_mapping = {
+    .mp_ass_subscript = tramp_mp_ass_subscript,
+};
 #endif
 
-    /* Tell runtime the type dict changed - PyType_Modified returns void, but call for correctness */
-    PyType_Modified(tp);
+/* Filled from list_wrappers at module init */
+static PyMethodDef native_list_methods[N_SHADOWED + 1];
+
+static PyTypeObject ReaktomeList_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "_reaktome.ReaktomeList",
+    .tp_basicsize = sizeof(reaktome_list),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "list with its reaktome hooks built in",
+    .tp_dealloc = native_list_dealloc,
+    .tp_traverse = native_list_traverse,
+    .tp_clear = native_list_clear,
+    .tp_as_sequence = &native_list_as_sequence,
+#if PY_VERSION_HEX >= 0x03090000
+    .tp_as_mapping = &native_list_as_mapping,
+#endif
+    .tp_methods = native_list_methods,
+};
 
-    already_patched = 1;
-    return 0;
+/* Never uninstalled: everything is built in */
+static list_install native_install;
+
+/* Record PyList_Type's own slots and methods as ReaktomeList's originals,
+   then ready and register the type. */
+static int
+native_list_init(PyObject *m)
+{
+    native_install.slots = ALL_SLOTS;
+    native_install.sq_ass_item = orig_sq_ass_item(&PyList_Type);
+    native_install.sq_inplace_concat = orig_sq_inplace_concat(&PyList_Type);
+    native_install.sq_inplace_repeat = orig_sq_inplace_repeat(&PyList_Type);
+#if PY_VERSION_HEX >= 0x03090000
+    native_install.mp_ass_subscript = orig_mp_ass_subscript(&PyList_Type);
+#else
+    native_install.sq_ass_slice = orig_sq_ass_slice(&PyList_Type);
+#endif
+    for (int i = 0; i < N_SHADOWED; i++) {
+        native_list_methods[i] = *list_wrappers[i].def;
+        PyObject *orig = orig_method(&PyList_Type, i); /* borrowed */
+        if (!orig) return -1;
+        native_install.orig_methods[i] = Py_NewRef(orig);
+        native_install.users[i] = 1;
+        native_install.methods |= 1u << i;
+    }
+
+    ReaktomeList_Type.tp_base = &PyList_Type;
+    if (PyType_Ready(&ReaktomeList_Type) < 0) return -1;
+    if (!ptr_table_insert(&list_installs, &ReaktomeList_Type, &native_install)) return -1;
+    if (activation_register_inline(&ReaktomeList_Type,
+                                   offsetof(reaktome_list, entry)) < 0) return -1;
+    return PyModule_AddObjectRef(m, "ReaktomeList", (PyObject *)&ReaktomeList_Type);
 }
 
 /* ---------- Python wrapper: py_patch_list(instance, dunders) ---------- */
@@ -421,13 +1142,21 @@ py_patch_list(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    /* Ensure trampolines installed for the list type */
-    if (ensure_list_type_patched(Py_TYPE(inst)) < 0) {
+    /* ReaktomeList has the trampolines built in */
+    if (activation_is_inline(inst)) {
+        if (activation_merge(inst, dunders) < 0) return NULL;
+        Py_RETURN_NONE;
+    }
+
+    /* Install what these hooks need on inst's own type (not needed to clear) */
+    if (dunders != Py_None &&
+        ensure_list_type_patched(Py_TYPE(inst), activation_hook_mask(dunders)) < 0) {
         return NULL;
     }
 
-    /* Merge hooks for this instance (activation side-table). dunders may be None to clear. */
-    if (activation_merge(inst, dunders) < 0) {
+    /* Merge hooks for this instance (activation side-table). dunders may be None
+       to clear; the last cleared instance of the type uninstalls the trampolines. */
+    if (activation_merge_installed(inst, dunders, Py_TYPE(inst)) < 0) {
         return NULL;
     }
 
@@ -446,5 +1175,10 @@ reaktome_patch_list(PyObject *m)
 {
     if (!m) return -1;
     if (PyModule_AddFunctions(m, list_module_methods) < 0) return -1;
+    for (int i = 0; i < N_SHADOWED; i++) {
+        wrapper_names[i] = PyUnicode_InternFromString(list_wrappers[i].name);
+        if (!wrapper_names[i]) return -1;
+    }
+    if (native_list_init(m) < 0) return -1;
     return 0;
 }
@@ -2,121 +2,216 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include "activation.h"
+#include "ptr_table.h"
+#include "stats.h"
 #include "reaktome.h"
 
 /*
  obj.c — implementation that:
   - installs a single trampoline into tp_setattro for heap types,
-  - stores the real original tp_setattro per-type in module-local dict
-    BEFORE replacing the type slot (so we never record the trampoline itself),
-  - stores per-instance originals in the activation side-table (capsules),
-  - trampoline uses per-instance capsule if present, else falls back to per-type original,
-  - trampoline calls original (or generic fallback) then advisory hooks via reaktome_call_dunder,
+  - stores the real original tp_setattro per-type in a module-local pointer
+    table BEFORE replacing the type slot (so we never record the trampoline itself),
+  - trampoline resolves the instance's compiled hooks once, calls the original
+    (or generic fallback) and the advisory hooks taken from that lookup,
   - additionally installs method wrappers (append/extend/insert/pop/remove/clear)
     into heap types' tp_dict for list-like behaviour; saved original method objects
-    are kept in `type_orig_methods`.
+    are kept in `type_orig_methods`,
+  - undoes all of the above per type once its last activated instance is
+    gone (uninstall_type_trampolines).
 */
 
-/* module-local dict mapping type -> capsule(original tp_setattro). newref or NULL */
-static PyObject *type_orig_capsules = NULL;
+/* module-local table mapping type -> original tp_setattro (raw pointers) */
+static ptr_table type_orig_setattros;
 
 /* module-local dict mapping type -> dict(method_name -> original_method_obj). newref or NULL */
 static PyObject *type_orig_methods = NULL;
 
+/* module-local dict mapping type -> dict(method_name -> entry the type's own dict held
+   before shadowing); names absent here were inherited and are simply deleted again */
+static PyObject *type_own_methods = NULL;
+
+static int tramp_tp_setattro(PyObject *self, PyObject *name, PyObject *value);
+
 /* Helper: call activation dunder and swallow exceptions */
 static inline void
 call_hook_advisory_obj(PyObject *self,
-                       const char *dunder_name,
+                       reaktome_hook hook,
                        PyObject *key,
                        PyObject *old,
                        PyObject *newv)
 {
-    if (reaktome_call_dunder(self, dunder_name, key, old, newv) < 0) {
+    if (reaktome_call_hook(self, hook, key, old, newv) < 0) {
         PyErr_Clear();
     }
 }
 
-/* ---------- getattr helper: get per-instance hooks dict (newref or NULL no-exc) ---------- */
-/* activation_get_hooks already supplies a newref or NULL and no exception on none; reuse it. */
+/* Same with an index key, allocated only if the hook is registered. */
+static inline void
+call_index_hook_advisory_obj(PyObject *self,
+                             reaktome_hook hook,
+                             Py_ssize_t index,
+                             PyObject *old,
+                             PyObject *newv)
+{
+    if (reaktome_call_hook_index(self, hook, index, old, newv) < 0) {
+        PyErr_Clear();
+    }
+}
 
-/* ---------- Trampoline installed into tp_setattro (handles both setattr and delattr) ---------- */
-static int
-tramp_tp_setattro(PyObject *self, PyObject *name, PyObject *value)
+/* Per-type original tp_setattro saved before patching; walks tp_base so
+   subclasses that inherited the trampoline find their patched ancestor, or
+   the restored slot of an ancestor that has been uninstalled since. */
+static setattrofunc
+type_orig_setattro(PyTypeObject *tp)
 {
-    /* Snapshot old value (if present) for hook reporting */
-    PyObject *old = PyObject_GetAttr(self, name); /* newref or NULL */
-    if (!old) {
-        if (PyErr_Occurred()) {
-            if (PyErr_ExceptionMatches(PyExc_AttributeError)) {
-                PyErr_Clear();
-            } else {
-                return -1;
-            }
-        }
+    for (; tp; tp = tp->tp_base) {
+        ptr_entry *e = ptr_table_find(&type_orig_setattros, tp);
+        if (e) return (setattrofunc)e->value;
+        if (tp->tp_setattro != tramp_tp_setattro) return tp->tp_setattro;
     }
+    return NULL;
+}
 
-    /* Advisory pre-mutation hook: distinguish between setattr and delattr */
-    const char *dunder_call = (value == NULL) ? "__delattr__" : "__setattr__";
-    call_hook_advisory_obj(self, dunder_call, name, old, value);
+/* ---------- old-value capture ---------- */
 
-    /* Find original pointer to call */
-    void *orig_ptr = NULL;
+/* object.__getattribute__, to tell types that merely add __getattr__
+   (tp_getattro becomes slot_tp_getattr_hook) from real overrides */
+static PyObject *getattribute_str = NULL;
+static PyObject *object_getattribute = NULL;   /* borrowed from object's dict */
 
-    PyObject *hooks = activation_get_hooks(self); /* newref or NULL */
-    if (hooks) {
-        const char *inst_key = (value == NULL) ? "__orig_delattr__" : "__orig_setattr__";
-        PyObject *caps = PyDict_GetItemString(hooks, inst_key); /* borrowed */
-        if (caps) {
-            orig_ptr = PyCapsule_GetPointer(caps, NULL);
-            if (!orig_ptr && PyErr_Occurred()) {
-                Py_DECREF(hooks);
-                Py_XDECREF(old);
-                return -1;
-            }
-        }
-        Py_DECREF(hooks);
-    } else {
-        PyErr_Clear();
+static int
+default_getattribute(PyTypeObject *tp)
+{
+    if (tp->tp_getattro == PyObject_GenericGetAttr) return 1;
+    if (!getattribute_str) {
+        getattribute_str = PyUnicode_InternFromString("__getattribute__");
+        if (!getattribute_str) { PyErr_Clear(); return 0; }
+        object_getattribute = _PyType_Lookup(&PyBaseObject_Type, getattribute_str);
     }
+    return _PyType_Lookup(tp, getattribute_str) == object_getattribute;
+}
 
-    if (!orig_ptr && type_orig_capsules) {
-        PyObject *caps_type = PyDict_GetItem(type_orig_capsules, (PyObject *)Py_TYPE(self)); /* borrowed */
-        if (caps_type) {
-            orig_ptr = PyCapsule_GetPointer(caps_type, NULL);
-            if (!orig_ptr && PyErr_Occurred()) {
-                Py_XDECREF(old);
-                return -1;
-            }
-        }
+/* The value getattr(self, name) returns (newref in *old), or NULL in *old
+   if it raises AttributeError. Returns -1 with any other exception. */
+static int
+generic_attr(PyObject *self, PyObject *name, PyObject **old)
+{
+    *old = PyObject_GetAttr(self, name);
+    if (*old || !PyErr_ExceptionMatches(PyExc_AttributeError)) return *old ? 0 : -1;
+    PyErr_Clear();
+    return 0;
+}
+
+/* Same result as generic_attr, read straight from storage for plain data
+   attributes: the instance __dict__, or a __slots__ member. Properties and
+   other data descriptors, class-level defaults, __getattr__ fallbacks and
+   custom __getattribute__ still go through getattr. */
+static int
+current_attr(PyObject *self, PyObject *name, PyObject **old)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    if (!PyUnicode_CheckExact(name) || !default_getattribute(tp))
+        return generic_attr(self, name, old);
+
+    PyObject *descr = _PyType_Lookup(tp, name); /* borrowed */
+    if (descr && Py_TYPE(descr)->tp_descr_set) {
+        /* data descriptors win over the instance dict */
+        if (!Py_IS_TYPE(descr, &PyMemberDescr_Type))
+            return generic_attr(self, name, old);
+        /* __slots__ member: the getter reads the slot, raising if unset */
+        *old = Py_TYPE(descr)->tp_descr_get(descr, self, (PyObject *)tp);
+        if (*old || !PyErr_ExceptionMatches(PyExc_AttributeError)) return *old ? 0 : -1;
+        PyErr_Clear();
+        return 0;
     }
 
-    int rc;
-    if (orig_ptr) {
-        setattrofunc orig = (setattrofunc)orig_ptr;
-        rc = orig(self, name, value);
-    } else {
-        /* Fallback to generic if no original found */
-        rc = (value == NULL)
-            ? PyObject_GenericSetAttr(self, name, NULL)   /* true delattr */
-            : PyObject_GenericSetAttr(self, name, value); /* setattr */
+#ifdef Py_TPFLAGS_MANAGED_DICT
+    if (tp->tp_flags & Py_TPFLAGS_MANAGED_DICT) {
+        /* attributes may live inline; _PyObject_GetDictPtr would give the
+           instance a real __dict__ just to read one, the generic lookup
+           reads them in place */
+        *old = _PyObject_GenericGetAttrWithDict(self, name, NULL, 1);
+        if (*old) return 0;
+        if (PyErr_Occurred()) return -1;
+        if (tp->tp_getattro != PyObject_GenericGetAttr)
+            return generic_attr(self, name, old);
+        return 0;
+    }
+#endif
+
+    PyObject **dictptr = _PyObject_GetDictPtr(self);
+    PyObject *dict = dictptr ? *dictptr : NULL;
+    if (dict) {
+        *old = Py_XNewRef(PyDict_GetItemWithError(dict, name)); /* borrowed */
+        if (*old) return 0;
+        if (PyErr_Occurred()) return -1;
     }
+    /* not stored: a class attribute or __getattr__ may still answer */
+    if (descr || tp->tp_getattro != PyObject_GenericGetAttr)
+        return generic_attr(self, name, old);
+    *old = NULL;
+    return 0;
+}
+
+/* ---------- Trampoline installed into tp_setattro (handles both setattr and delattr) ---------- */
+static int
+tramp_tp_setattro(PyObject *self, PyObject *name, PyObject *value)
+{
+    setattrofunc orig = type_orig_setattro(Py_TYPE(self));
+    if (!orig) orig = PyObject_GenericSetAttr;   /* no original found */
+
+    /* Unobserved instances: no old-value snapshot, straight to the original */
+    const reaktome_hooks *h = activation_lookup_active(self); /* borrowed or NULL */
+    if (!h) return orig(self, name, value);
 
-    if (rc < 0) {
-        Py_XDECREF(old);
+    /* Names its filter drops (e.g. private attributes) likewise */
+    if (!activation_filter_passes(h, name)) return orig(self, name, value);
+
+    /* Take what this call needs from the one lookup: the old-value read
+       and the hooks below can run Python that changes the side-table. */
+    reaktome_hook pre_id = value ? REAKTOME_HOOK_PRE_SETATTR : REAKTOME_HOOK_PRE_DELATTR;
+    reaktome_hook post_id = value ? REAKTOME_HOOK_SETATTR : REAKTOME_HOOK_DELATTR;
+    PyObject *pre = Py_XNewRef(h->hooks[pre_id]);
+    PyObject *post = Py_XNewRef(h->hooks[post_id]);
+    reaktome_noop mode = h->skip_noop;
+
+    /* Snapshot old value (if present) for hook reporting */
+    PyObject *old; /* newref or NULL */
+    if (current_attr(self, name, &old) < 0) {
+        Py_XDECREF(pre);
+        Py_XDECREF(post);
         return -1;
     }
 
+    /* Reassigning the same (or, if asked, an equal) value: store it quietly */
+    int noop = activation_noop_matches(mode, old, value);
+
+    /* Advisory pre-mutation hook: distinguish between setattr and delattr.
+       It may change the activation, so the post hook is looked up again. */
+    if (pre && !noop) {
+        if (reaktome_call_hook_object(pre, self, pre_id, name, old, value) < 0)
+            PyErr_Clear();
+        Py_XSETREF(post, NULL);
+        h = activation_lookup(self);
+        if (h) post = Py_XNewRef(h->hooks[post_id]);
+    }
+    Py_XDECREF(pre);
+
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc = orig(self, name, value);
+    REAKTOME_STATS_OP(self, value ? REAKTOME_OP_SETATTR : REAKTOME_OP_DELATTR, t0);
+
     /* Post-mutation hook: distinguish between actual setattr vs actual delattr.
        This is where we need __reaktome_delattr__, otherwise setattr(x, None)
        and delattr(x) would look identical. */
-    if (value == NULL) {
-        call_hook_advisory_obj(self, "__reaktome_delattr__", name, old, NULL);
-    } else {
-        call_hook_advisory_obj(self, "__reaktome_setattr__", name, old, value);
+    if (rc == 0 && post && (value == NULL || !noop)) {
+        if (reaktome_call_hook_object(post, self, post_id, name, old, value) < 0)
+            PyErr_Clear();
     }
 
+    Py_XDECREF(post);
     Py_XDECREF(old);
-    return 0;
+    return rc < 0 ? -1 : 0;
 }
 
 /* ---------- method trampolines for heap types (append/extend/insert/pop/remove/clear) ---------- */
@@ -142,6 +237,7 @@ tramp_append(PyObject *self, PyObject *arg)
 {
     Py_ssize_t idx = PyList_GET_SIZE(self);
 
+    int64_t t0 = REAKTOME_STATS_START();
     PyObject *orig = get_saved_method(Py_TYPE(self), "append");
     PyObject *res;
 
@@ -157,15 +253,12 @@ tramp_append(PyObject *self, PyObject *arg)
     }
 
     if (!res) return NULL; /* propagate exception */
+    if (!activation_is_active(self)) return res;
+    REAKTOME_STATS_OP(self, REAKTOME_OP_APPEND, t0);
 
-    PyObject *key = PyLong_FromSsize_t(idx);
-    if (!key)
-        return NULL;
-
-    /* after success, call setitem advisory with new value arg; key unknown for sequence */
-    call_hook_advisory_obj(self, "__reaktome_setitem__", key, NULL, arg);
+    /* after success, call setitem advisory with new value arg */
+    call_index_hook_advisory_obj(self, REAKTOME_HOOK_SETITEM, idx, NULL, arg);
 
-    Py_DECREF(key);
     Py_DECREF(res);
     Py_RETURN_NONE;
 }
@@ -176,6 +269,7 @@ tramp_extend(PyObject *self, PyObject *iterable)
 {
     Py_ssize_t idx = PyList_GET_SIZE(self);
 
+    int64_t t0 = REAKTOME_STATS_START();
     PyObject *orig = get_saved_method(Py_TYPE(self), "extend");
     PyObject *res;
 
@@ -189,17 +283,16 @@ tramp_extend(PyObject *self, PyObject *iterable)
     }
 
     if (!res) return NULL;
+    if (!activation_is_active(self)) return res;
+    REAKTOME_STATS_OP(self, REAKTOME_OP_EXTEND, t0);
 
     /* If iterable is iterable, call setitem advisory for each element (best-effort) */
     if (iterable && PyObject_GetIter(iterable)) {
         PyObject *it = PyObject_GetIter(iterable);
         if (it) {
             PyObject *item;
-            PyObject *key;
             while ((item = PyIter_Next(it))) {
-                key = PyLong_FromSsize_t(idx++);
-                call_hook_advisory_obj(self, "__reaktome_setitem__", key, NULL, item);
-                Py_DECREF(key);
+                call_index_hook_advisory_obj(self, REAKTOME_HOOK_SETITEM, idx++, NULL, item);
                 Py_DECREF(item);
             }
             Py_DECREF(it);
@@ -213,34 +306,30 @@ tramp_extend(PyObject *self, PyObject *iterable)
 
 /* insert(self, index, value) */
 static PyObject *
-tramp_insert(PyObject *self, PyObject *args)
+tramp_insert(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
-    Py_ssize_t idx;
-    PyObject *val;
-    if (!PyArg_ParseTuple(args, "nO:insert", &idx, &val)) return NULL;
+    if (!reaktome_check_nargs("insert", nargs, 2, 2)) return NULL;
+    Py_ssize_t idx = PyNumber_AsSsize_t(args[0], PyExc_OverflowError);
+    if (idx == -1 && PyErr_Occurred()) return NULL;
 
+    int64_t t0 = REAKTOME_STATS_START();
     PyObject *orig = get_saved_method(Py_TYPE(self), "insert");
     PyObject *res;
 
     if (orig) {
-        PyObject *iobj = PyLong_FromSsize_t(idx);
-        if (!iobj) return NULL;
-        res = PyObject_CallFunctionObjArgs(orig, self, iobj, val, NULL);
-        Py_DECREF(iobj);
+        res = reaktome_call_orig(orig, self, args, nargs, NULL);
     } else {
         PyObject *callable = PyObject_GetAttrString((PyObject *)Py_TYPE(self), "insert");
         if (!callable) return NULL;
-        res = PyObject_CallFunctionObjArgs(callable, self, PyLong_FromSsize_t(idx), val, NULL);
+        res = reaktome_call_orig(callable, self, args, nargs, NULL);
         Py_DECREF(callable);
     }
 
     if (!res) return NULL;
+    if (!activation_is_active(self)) return res;
+    REAKTOME_STATS_OP(self, REAKTOME_OP_INSERT, t0);
 
-    PyObject *key = PyLong_FromSsize_t(idx);
-    if (key) {
-        call_hook_advisory_obj(self, "__reaktome_setitem__", key, NULL, val);
-        Py_DECREF(key);
-    }
+    call_index_hook_advisory_obj(self, REAKTOME_HOOK_SETITEM, idx, NULL, args[1]);
 
     Py_DECREF(res);
     Py_RETURN_NONE;
@@ -248,44 +337,28 @@ tramp_insert(PyObject *self, PyObject *args)
 
 /* pop(self[, index]) -> returns popped value */
 static PyObject *
-tramp_pop(PyObject *self, PyObject *args)
+tramp_pop(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
-    Py_ssize_t idx = -1;
-    PyObject *res = NULL;
-    int have_index = 0;
-
-    if (!PyArg_ParseTuple(args, "|n:pop", &idx)) return NULL;
-
-    if (idx != -1) have_index = 1;
+    if (!reaktome_check_nargs("pop", nargs, 0, 1)) return NULL;
 
+    int64_t t0 = REAKTOME_STATS_START();
     PyObject *orig = get_saved_method(Py_TYPE(self), "pop");
+    PyObject *res;
     if (orig) {
-        if (have_index) {
-            PyObject *iobj = PyLong_FromSsize_t(idx);
-            if (!iobj) return NULL;
-            res = PyObject_CallFunctionObjArgs(orig, self, iobj, NULL);
-            Py_DECREF(iobj);
-        } else {
-            res = PyObject_CallFunctionObjArgs(orig, self, NULL);
-        }
+        res = reaktome_call_orig(orig, self, args, nargs, NULL);
     } else {
         PyObject *callable = PyObject_GetAttrString((PyObject *)Py_TYPE(self), "pop");
         if (!callable) return NULL;
-        if (have_index) {
-            PyObject *iobj = PyLong_FromSsize_t(idx);
-            if (!iobj) { Py_DECREF(callable); return NULL; }
-            res = PyObject_CallFunctionObjArgs(callable, self, iobj, NULL);
-            Py_DECREF(iobj);
-        } else {
-            res = PyObject_CallFunctionObjArgs(callable, self, NULL);
-        }
+        res = reaktome_call_orig(callable, self, args, nargs, NULL);
         Py_DECREF(callable);
     }
 
+    if (activation_is_active(self))
+        REAKTOME_STATS_OP(self, REAKTOME_OP_POP, t0);
     if (!res) return NULL; /* exception */
 
     /* res is the popped value (old). Fire del hook */
-    call_hook_advisory_obj(self, "__reaktome_delitem__", NULL, res, NULL);
+    call_hook_advisory_obj(self, REAKTOME_HOOK_DELITEM, NULL, res, NULL);
 
     return res; /* newref returned to caller */
 }
@@ -294,6 +367,7 @@ tramp_pop(PyObject *self, PyObject *args)
 static PyObject *
 tramp_remove(PyObject *self, PyObject *arg)
 {
+    int64_t t0 = REAKTOME_STATS_START();
     PyObject *orig = get_saved_method(Py_TYPE(self), "remove");
     PyObject *res;
 
@@ -306,10 +380,12 @@ tramp_remove(PyObject *self, PyObject *arg)
         Py_DECREF(callable);
     }
 
+    if (activation_is_active(self))
+        REAKTOME_STATS_OP(self, REAKTOME_OP_REMOVE, t0);
     if (!res) return NULL;
 
     /* remove triggers a delitem advisory for the removed element (we don't have index) */
-    call_hook_advisory_obj(self, "__reaktome_delitem__", NULL, arg, NULL);
+    call_hook_advisory_obj(self, REAKTOME_HOOK_DELITEM, NULL, arg, NULL);
 
     Py_DECREF(res);
     Py_RETURN_NONE;
@@ -321,11 +397,12 @@ tramp_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
 {
     /* Snapshot items if possible and call del hooks per item */
     PyObject *items = NULL;
-    if (PyObject_HasAttrString(self, "__iter__")) {
+    if (activation_is_active(self) && PyObject_HasAttrString(self, "__iter__")) {
         items = PySequence_List(self); /* newref or NULL; best-effort */
         if (!items && PyErr_Occurred()) PyErr_Clear();
     }
 
+    int64_t t0 = REAKTOME_STATS_START();
     PyObject *orig = get_saved_method(Py_TYPE(self), "clear");
     PyObject *res;
     if (orig) {
@@ -352,6 +429,8 @@ tramp_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
         }
     }
 
+    if (activation_is_active(self))
+        REAKTOME_STATS_OP(self, REAKTOME_OP_CLEAR, t0);
     if (!res) return NULL;
 
     /* Fire del hooks for each old item we managed to take a snapshot of */
@@ -360,7 +439,7 @@ tramp_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
         for (Py_ssize_t i = 0; i < n; i++) {
             PyObject *it = PyList_GetItem(items, i); /* borrowed */
             if (!it) continue;
-            call_hook_advisory_obj(self, "__reaktome_delitem__", NULL, it, NULL);
+            call_hook_advisory_obj(self, REAKTOME_HOOK_DELITEM, NULL, it, NULL);
         }
         Py_DECREF(items);
     }
@@ -372,11 +451,52 @@ tramp_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
 /* ---------- static PyMethodDef objects for wrappers (file scope) ---------- */
 static PyMethodDef append_def  = {"append",  (PyCFunction)tramp_append,  METH_O,       "append (trampoline)"};
 static PyMethodDef extend_def  = {"extend",  (PyCFunction)tramp_extend,  METH_O,       "extend (trampoline)"};
-static PyMethodDef insert_def  = {"insert",  (PyCFunction)tramp_insert,  METH_VARARGS, "insert (trampoline)"};
-static PyMethodDef pop_def     = {"pop",     (PyCFunction)tramp_pop,     METH_VARARGS, "pop (trampoline)"};
+static PyMethodDef insert_def  = {"insert",  (PyCFunction)(void(*)(void))tramp_insert, METH_FASTCALL, "insert (trampoline)"};
+static PyMethodDef pop_def     = {"pop",     (PyCFunction)(void(*)(void))tramp_pop,    METH_FASTCALL, "pop (trampoline)"};
 static PyMethodDef remove_def  = {"remove",  (PyCFunction)tramp_remove,  METH_O,       "remove (trampoline)"};
 static PyMethodDef clear_def   = {"clear",   (PyCFunction)tramp_clear,   METH_NOARGS,  "clear (trampoline)"};
 
+/* ---------- Undo ensure_type_trampolines_installed for one type. ---------- */
+/* Runs once the last activated instance of tp is gone (or on unpatch_all). */
+static void
+uninstall_type_trampolines(PyTypeObject *tp)
+{
+    if (tp->tp_setattro == tramp_tp_setattro) {
+        setattrofunc orig = type_orig_setattro(tp);
+        tp->tp_setattro = orig ? orig : PyObject_GenericSetAttr;
+    }
+
+    PyObject *tp_dict = PyType_GetDict(tp); /* newref */
+    PyObject *saved = type_orig_methods
+        ? PyDict_GetItem(type_orig_methods, (PyObject *)tp) /* borrowed */
+        : NULL;
+    PyObject *own = type_own_methods
+        ? PyDict_GetItem(type_own_methods, (PyObject *)tp) /* borrowed */
+        : NULL;
+    if (tp_dict && saved) {
+        Py_ssize_t pos = 0;
+        PyObject *name, *value;
+        while (PyDict_Next(saved, &pos, &name, &value)) {
+            PyObject *prev = own ? PyDict_GetItem(own, name) : NULL; /* borrowed */
+            int rc = prev ? PyDict_SetItem(tp_dict, name, prev)
+                          : PyDict_DelItem(tp_dict, name);
+            if (rc < 0) PyErr_Clear();
+        }
+    }
+    if (tp_dict && PyDict_DelItemString(tp_dict, "__reaktome_type_patched__") < 0)
+        PyErr_Clear();
+    Py_XDECREF(tp_dict);
+
+    ptr_table_pop(&type_orig_setattros, tp);
+
+    PyObject *maps[] = {type_orig_methods, type_own_methods};
+    for (size_t i = 0; i < sizeof(maps) / sizeof(maps[0]); i++) {
+        if (maps[i] && PyDict_DelItem(maps[i], (PyObject *)tp) < 0) PyErr_Clear();
+    }
+
+    PyType_Modified(tp);
+}
+
 /* ---------- Ensure trampolines installed once per heap (user-defined) type. ---------- */
 static int
 ensure_type_trampolines_installed(PyTypeObject *tp)
@@ -387,38 +507,33 @@ ensure_type_trampolines_installed(PyTypeObject *tp)
         return -1;
     }
 
-    /* Guard: if already patched, nothing to do */
-    PyObject *already = PyObject_GetAttrString((PyObject *)tp, "__reaktome_type_patched__");
-    if (already) {
-        Py_DECREF(already);
-        return 0;
-    } else if (PyErr_Occurred()) {
-        PyErr_Clear();
-    }
+    /* Guard: if already patched, nothing to do. Checked per type rather than
+       via the (inherited) sentinel, so subclasses get their own install. */
+    if (activation_installed(tp, uninstall_type_trampolines)) return 0;
 
     /* prepare per-type modules maps */
-    if (!type_orig_capsules) {
-        type_orig_capsules = PyDict_New();
-        if (!type_orig_capsules) return -1;
-    }
     if (!type_orig_methods) {
         type_orig_methods = PyDict_New();
         if (!type_orig_methods) return -1;
     }
+    if (!type_own_methods) {
+        type_own_methods = PyDict_New();
+        if (!type_own_methods) return -1;
+    }
 
-    /* Save per-type original tp_setattro (capsule) if not present */
-    if (!PyDict_GetItem(type_orig_capsules, (PyObject *)tp)) {
-        if (tp->tp_setattro) {
-            PyObject *caps = PyCapsule_New((void *)tp->tp_setattro, NULL, NULL);
-            if (!caps) return -1;
-            if (PyDict_SetItem(type_orig_capsules, (PyObject *)tp, caps) < 0) {
-                Py_DECREF(caps);
-                return -1;
-            }
-            Py_DECREF(caps);
-        }
+    /* Save per-type original tp_setattro if not present */
+    if (!ptr_table_find(&type_orig_setattros, tp)) {
+        /* a subclass may have inherited the trampoline itself */
+        setattrofunc orig = tp->tp_setattro == tramp_tp_setattro
+            ? type_orig_setattro(tp->tp_base)
+            : tp->tp_setattro;
+        if (orig && !ptr_table_insert(&type_orig_setattros, tp, (void *)orig))
+            return -1;
     }
 
+    /* Evict side-table entries when instances die */
+    if (activation_evict_on_dealloc(tp) < 0) return -1;
+
     /* Install tp_setattro trampoline */
     tp->tp_setattro = tramp_tp_setattro;
 
@@ -466,6 +581,25 @@ ensure_type_trampolines_installed(PyTypeObject *tp)
 
     #undef SAVE_ORIG_METHOD_IF_PRESENT
 
+    /* Remember which of those the type's own dict held, for uninstall */
+    PyObject *saved = PyDict_GetItem(type_orig_methods, (PyObject *)tp); /* borrowed */
+    if (saved) {
+        PyObject *own = PyDict_New();
+        if (!own) return -1;
+        Py_ssize_t pos = 0;
+        PyObject *name, *value;
+        while (PyDict_Next(saved, &pos, &name, &value)) {
+            PyObject *prev = PyDict_GetItemWithError(tp_dict, name); /* borrowed */
+            if (!prev && PyErr_Occurred()) { Py_DECREF(own); return -1; }
+            if (prev && PyDict_SetItem(own, name, prev) < 0) { Py_DECREF(own); return -1; }
+        }
+        if (PyDict_SetItem(type_own_methods, (PyObject *)tp, own) < 0) {
+            Py_DECREF(own);
+            return -1;
+        }
+        Py_DECREF(own);
+    }
+
     /* helper macro: install wrapper descriptor into type dict */
     #define INSTALL_DEF_IN_DICT(defptr, name_lit)                             \
         do {                                                                  \
@@ -499,10 +633,13 @@ ensure_type_trampolines_installed(PyTypeObject *tp)
     }
 
     PyType_Modified(tp);
+
+    /* Activations of tp's instances hold this install */
+    if (activation_install(tp, uninstall_type_trampolines) < 0) return -1;
     return 0;
 }
 
-/* ---------- Store the type’s slot originals into the activation side-table for inst. ---------- */
+/* ---------- Store the type’s method originals into the activation side-table for inst. ---------- */
 static int
 store_type_slot_originals_in_side_table(PyObject *inst)
 {
@@ -510,46 +647,7 @@ store_type_slot_originals_in_side_table(PyObject *inst)
     PyObject *orig_dict = PyDict_New();
     if (!orig_dict) return -1;
 
-    void *orig_ptr_for_instance = NULL;
-
-    if (tp->tp_setattro == tramp_tp_setattro) {
-        if (type_orig_capsules) {
-            PyObject *caps_type = PyDict_GetItem(type_orig_capsules, (PyObject *)tp);
-            if (caps_type) {
-                orig_ptr_for_instance = PyCapsule_GetPointer(caps_type, NULL);
-                if (!orig_ptr_for_instance && PyErr_Occurred()) {
-                    Py_DECREF(orig_dict);
-                    return -1;
-                }
-            }
-        }
-    } else {
-        if (tp->tp_setattro) {
-            orig_ptr_for_instance = (void *)tp->tp_setattro;
-        }
-    }
-
-    if (orig_ptr_for_instance) {
-        PyObject *cset = PyCapsule_New(orig_ptr_for_instance, NULL, NULL);
-        if (!cset) { Py_DECREF(orig_dict); return -1; }
-        if (PyDict_SetItemString(orig_dict, "__orig_setattr__", cset) < 0) {
-            Py_DECREF(cset);
-            Py_DECREF(orig_dict);
-            return -1;
-        }
-        Py_DECREF(cset);
-
-        PyObject *cdel = PyCapsule_New(orig_ptr_for_instance, NULL, NULL);
-        if (!cdel) { Py_DECREF(orig_dict); return -1; }
-        if (PyDict_SetItemString(orig_dict, "__orig_delattr__", cdel) < 0) {
-            Py_DECREF(cdel);
-            Py_DECREF(orig_dict);
-            return -1;
-        }
-        Py_DECREF(cdel);
-    }
-
-    /* Also capture per-type original method objects (if any) and stash them in instance side-table
+    /* Capture per-type original method objects (if any) and stash them in instance side-table
        under keys so per-instance lookup prefers per-instance originals (if present). */
     if (type_orig_methods) {
         PyObject *per = PyDict_GetItem(type_orig_methods, (PyObject *)tp); /* borrowed */
@@ -577,6 +675,35 @@ store_type_slot_originals_in_side_table(PyObject *inst)
     return 0;
 }
 
+/* Instances of tp keep attributes somewhere setattr reaches: an instance
+   __dict__, or a writable member descriptor (a __slots__ entry, including
+   @dataclass(slots=True) fields) somewhere in the MRO. Slot writes go
+   through tp_setattro like any other, so the same trampoline covers them. */
+static int
+has_attribute_storage(PyTypeObject *tp)
+{
+    if (tp->tp_dictoffset || PyType_HasFeature(tp, Py_TPFLAGS_MANAGED_DICT))
+        return 1;
+
+    PyObject *mro = tp->tp_mro; /* borrowed */
+    Py_ssize_t n = mro ? PyTuple_GET_SIZE(mro) : 0;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *dict = PyType_GetDict((PyTypeObject *)PyTuple_GET_ITEM(mro, i)); /* newref */
+        if (!dict) continue;
+        Py_ssize_t pos = 0;
+        PyObject *name, *value;
+        while (PyDict_Next(dict, &pos, &name, &value)) {
+            if (Py_IS_TYPE(value, &PyMemberDescr_Type) &&
+                !(((PyMemberDescrObject *)value)->d_member->flags & Py_READONLY)) {
+                Py_DECREF(dict);
+                return 1;
+            }
+        }
+        Py_DECREF(dict);
+    }
+    return 0;
+}
+
 /* ---------- py_patch_obj(instance, dunders) (idempotent) ---------- */
 static PyObject *
 py_patch_obj(PyObject *self, PyObject *args)
@@ -586,18 +713,26 @@ py_patch_obj(PyObject *self, PyObject *args)
     if (!PyArg_ParseTuple(args, "OO:patch_obj", &inst, &dunders))
         return NULL;
 
-    if (!PyObject_HasAttrString(inst, "__dict__")) {
+    PyTypeObject *tp = Py_TYPE(inst);
+    if (!has_attribute_storage(tp)) {
         PyErr_SetString(PyExc_TypeError,
-                        "patch_obj: instance has no __dict__");
+                        "patch_obj: instance has no __dict__ or __slots__");
         return NULL;
     }
 
+    /* Clearing never installs anything; it may uninstall tp */
+    if (dunders == Py_None) {
+        if (activation_merge_installed(inst, Py_None, tp) < 0)
+            return NULL;
+        Py_RETURN_NONE;
+    }
+
     /* --- NEW GUARD: if already activated, just merge dunders and return --- */
     PyObject *hooks = activation_get_hooks(inst); /* newref or NULL */
     if (hooks) {
         /* Already patched: skip re-installing trampolines; just merge dunders */
         Py_DECREF(hooks);
-        if (activation_merge(inst, dunders) < 0)
+        if (activation_merge_installed(inst, dunders, tp) < 0)
             return NULL;
         Py_RETURN_NONE;
     }
@@ -607,11 +742,10 @@ py_patch_obj(PyObject *self, PyObject *args)
     if (store_type_slot_originals_in_side_table(inst) < 0)
         return NULL;
 
-    PyTypeObject *tp = Py_TYPE(inst);
     if (ensure_type_trampolines_installed(tp) < 0)
         return NULL;
 
-    if (activation_merge(inst, dunders) < 0)
+    if (activation_merge_installed(inst, dunders, tp) < 0)
         return NULL;
 
     Py_RETURN_NONE;
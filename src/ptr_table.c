@@ -0,0 +1,101 @@
+/* src/ptr_table.c
+   Pointer-keyed open-addressing tables shared by the side-table and the
+   statistics (see ptr_table.h). */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "ptr_table.h"
+
+char ptr_table_tombstone;
+#define TOMBSTONE PTR_TABLE_TOMBSTONE
+
+#define TABLE_MIN_SIZE 8
+
+/* Rebuild the table with room for at least `minused` live entries.
+   Return 0 on success, -1 on error (MemoryError set). */
+static int
+ptr_table_resize(ptr_table *t, Py_ssize_t minused)
+{
+    size_t size = TABLE_MIN_SIZE;
+    while (size <= (size_t)minused * 2) size <<= 1;
+
+    ptr_entry *entries = PyMem_Calloc(size, sizeof(ptr_entry));
+    if (!entries) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    size_t mask = size - 1;
+    if (t->entries) {
+        for (size_t j = 0; j <= t->mask; j++) {
+            ptr_entry *e = &t->entries[j];
+            if (e->key == NULL || e->key == TOMBSTONE) continue;
+            size_t i = ptr_hash(e->key) & mask;
+            while (entries[i].key) i = (i + 1) & mask;
+            entries[i] = *e;
+        }
+        PyMem_Free(t->entries);
+    }
+
+    t->entries = entries;
+    t->mask = mask;
+    t->filled = t->used;
+    return 0;
+}
+
+ptr_entry *
+ptr_table_insert(ptr_table *t, const void *key, void *value)
+{
+    /* keep load (including tombstones) at or below 2/3 */
+    if (!t->entries || (size_t)(t->filled + 1) * 3 > (t->mask + 1) * 2) {
+        if (ptr_table_resize(t, t->used + 1) < 0) return NULL;
+    }
+
+    size_t i = ptr_hash(key) & t->mask;
+    ptr_entry *slot = NULL;
+    for (;;) {
+        ptr_entry *e = &t->entries[i];
+        if (e->key == NULL) {
+            if (!slot) {
+                slot = e;
+                t->filled++;
+            }
+            break;
+        }
+        if (e->key == TOMBSTONE && !slot) slot = e;
+        i = (i + 1) & t->mask;
+    }
+    slot->key = key;
+    slot->value = value;
+    t->used++;
+    return slot;
+}
+
+void *
+ptr_table_pop(ptr_table *t, const void *key)
+{
+    ptr_entry *e = ptr_table_find(t, key);
+    if (!e) return NULL;
+    void *value = e->value;
+    e->key = TOMBSTONE;
+    e->value = NULL;
+    t->used--;
+    return value;
+}
+
+const void **
+ptr_table_keys(const ptr_table *t, Py_ssize_t *n)
+{
+    const void **keys = PyMem_Malloc((t->used ? t->used : 1) * sizeof(void *));
+    if (!keys) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    Py_ssize_t k = 0;
+    for (size_t j = 0; t->used && j <= t->mask; j++) {
+        const void *key = t->entries[j].key;
+        if (key && key != TOMBSTONE) keys[k++] = key;
+    }
+    *n = k;
+    return keys;
+}
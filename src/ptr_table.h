@@ -0,0 +1,73 @@
+#ifndef REAKTOME_PTR_TABLE_H
+#define REAKTOME_PTR_TABLE_H
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Open-addressing hash tables keyed on a raw pointer (identity; never
+   dereferenced or incref'd). Linear probing over a power-of-two array.
+   Deleted slots become tombstones so probe chains stay intact; they are
+   dropped on the next resize. Ownership of `value` is up to the caller.
+   A zero-initialized ptr_table is empty and ready to use. */
+
+typedef struct {
+    const void *key;  /* NULL = empty, PTR_TABLE_TOMBSTONE = deleted */
+    void *value;
+} ptr_entry;
+
+typedef struct {
+    ptr_entry *entries;
+    size_t mask;        /* capacity - 1 */
+    Py_ssize_t used;    /* live entries */
+    Py_ssize_t filled;  /* live entries + tombstones */
+} ptr_table;
+
+extern char ptr_table_tombstone;
+#define PTR_TABLE_TOMBSTONE ((const void *)&ptr_table_tombstone)
+
+/* Objects are at least 16-byte aligned, so drop the low bits and mix the
+   rest (Fibonacci hashing) to spread neighbouring allocations. */
+static inline size_t
+ptr_hash(const void *p)
+{
+    uint64_t h = (uint64_t)(uintptr_t)p >> 4;
+    h *= 0x9E3779B97F4A7C15ull;
+    return (size_t)(h ^ (h >> 32));
+}
+
+/* Return the live entry for key, or NULL. */
+static inline ptr_entry *
+ptr_table_find(const ptr_table *t, const void *key)
+{
+    if (!t->used) return NULL;
+    size_t i = ptr_hash(key) & t->mask;
+    for (;;) {
+        ptr_entry *e = &t->entries[i];
+        if (e->key == key) return e;
+        if (e->key == NULL) return NULL;
+        i = (i + 1) & t->mask;
+    }
+}
+
+/* Insert key (which must not be present). Return the new entry, or NULL
+   with MemoryError set. */
+ptr_entry *ptr_table_insert(ptr_table *t, const void *key, void *value);
+
+/* Remove key and return its value, or NULL when absent. */
+void *ptr_table_pop(ptr_table *t, const void *key);
+
+/* Copy the live keys into a PyMem array (caller frees), so callers can
+   walk a snapshot while the table changes underneath. NULL + MemoryError
+   on failure; *n is set to the number of keys. */
+const void **ptr_table_keys(const ptr_table *t, Py_ssize_t *n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REAKTOME_PTR_TABLE_H */
@@ -1,4 +1,60 @@
 #include "reaktome.h"
+#include "activation.h"
+#include "stats.h"
+
+/* ---------- debug helpers wrapping activation_* ---------- */
+
+static PyObject *
+py_side_table_size(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyLong_FromSsize_t(activation_size());
+}
+
+static PyObject *
+py_unpatch_all(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (activation_unpatch_all() < 0) return NULL;
+    Py_RETURN_NONE;
+}
+
+/* ---------- opt-in statistics ---------- */
+
+static PyObject *
+py_enable_stats(PyObject *self, PyObject *args)
+{
+    int enabled = 1;
+    if (!PyArg_ParseTuple(args, "|p:enable_stats", &enabled)) return NULL;
+    int prev = reaktome_stats_enabled;
+    reaktome_stats_enabled = enabled;
+    return PyBool_FromLong(prev);
+}
+
+static PyObject *
+py_stats(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return reaktome_stats_snapshot();
+}
+
+static PyObject *
+py_reset_stats(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    reaktome_stats_reset();
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef reaktome_methods[] = {
+    {"side_table_size", (PyCFunction)py_side_table_size, METH_NOARGS,
+     "Number of entries in the activation side-table"},
+    {"unpatch_all", (PyCFunction)py_unpatch_all, METH_NOARGS,
+     "Deactivate everything and restore all patched slots and methods"},
+    {"enable_stats", (PyCFunction)py_enable_stats, METH_VARARGS,
+     "Turn statistics collection on or off; returns the previous setting"},
+    {"stats", (PyCFunction)py_stats, METH_NOARGS,
+     "Per-type operation and hook timings recorded while stats are enabled"},
+    {"reset_stats", (PyCFunction)py_reset_stats, METH_NOARGS,
+     "Discard all recorded statistics"},
+    {NULL, NULL, 0, NULL}
+};
 
 /* Module definition */
 static struct PyModuleDef reaktome_module = {
@@ -6,6 +62,7 @@ static struct PyModuleDef reaktome_module = {
     .m_name = "_reaktome",
     .m_doc = "Reaktome C extension for per-instance advisory hooks",
     .m_size = -1,
+    .m_methods = reaktome_methods,
 };
 
 /* Module init */
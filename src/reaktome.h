@@ -2,6 +2,8 @@
 #define REAKTOME_H
 
 #include <Python.h>
+#include <stddef.h>
+#include <string.h>
 
 /* Each container file provides one of these */
 int reaktome_patch_list(PyObject *m);
@@ -9,4 +11,51 @@ int reaktome_patch_dict(PyObject *m);
 int reaktome_patch_set(PyObject *m);
 int reaktome_patch_obj(PyObject *m);
 
+/* ---------- METH_FASTCALL trampolines ---------- */
+
+/* Positional argument count check with CPython's own wording
+   ("pop expected at most 2 arguments, got 3").
+   Returns 1, or 0 with TypeError set. */
+static inline int
+reaktome_check_nargs(const char *name, Py_ssize_t nargs,
+                     Py_ssize_t min, Py_ssize_t max)
+{
+    if (nargs >= min && nargs <= max) return 1;
+    Py_ssize_t want = nargs < min ? min : max;
+    PyErr_Format(PyExc_TypeError, "%s expected %s%zd argument%s, got %zd",
+                 name,
+                 min == max ? "" : nargs < min ? "at least " : "at most ",
+                 want, want == 1 ? "" : "s", nargs);
+    return 0;
+}
+
+/* Reject keyword arguments to a METH_FASTCALL | METH_KEYWORDS trampoline
+   that takes none. Returns 1, or 0 with TypeError set. */
+static inline int
+reaktome_no_kwnames(const char *name, PyObject *kwnames)
+{
+    if (!kwnames || PyTuple_GET_SIZE(kwnames) == 0) return 1;
+    PyErr_Format(PyExc_TypeError, "%s() takes no keyword arguments", name);
+    return 0;
+}
+
+/* Forward a FASTCALL trampoline's arguments to the saved original as
+   orig(self, *args, **kw) through vectorcall: the arguments (positional,
+   then keyword values) are copied behind self into a stack array, so no
+   tuple or dict is built. */
+static inline PyObject *
+reaktome_call_orig(PyObject *orig, PyObject *self,
+                   PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *small[5];
+    Py_ssize_t n = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0);
+    PyObject **stack = n < 5 ? small : PyMem_New(PyObject *, n + 1);
+    if (!stack) return PyErr_NoMemory();
+    stack[0] = self;
+    if (n) memcpy(stack + 1, args, n * sizeof(PyObject *));
+    PyObject *res = PyObject_Vectorcall(orig, stack, nargs + 1, kwnames);
+    if (stack != small) PyMem_Free(stack);
+    return res;
+}
+
 #endif /* REAKTOME_H */
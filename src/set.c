@@ -2,12 +2,15 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include "activation.h"
+#include "stats.h"
 #include "reaktome.h"
 
 /*
  * Patch the built-in set methods by replacing ml_meth pointers in
  * PySet_Type.tp_methods.  We save originals and install wrappers that
  * call the original then call reaktome_call_dunder(..., key=Py_None, ...).
+ * The in-place operators (|=, &=, -=, ^=) are slot trampolines on
+ * PySet_Type.tp_as_number.
  *
  * This changes behavior globally (like list slot patching).
  */
@@ -16,6 +19,21 @@
 static PyCFunction orig_add = NULL;
 static PyCFunction orig_discard = NULL;
 static PyCFunction orig_remove = NULL;
+static PyCFunction orig_pop = NULL;
+static PyCFunction orig_clear = NULL;
+static PyCFunction orig_symmetric_difference_update = NULL;
+/* update, difference_update and intersection_update take *others: METH_VARARGS
+   up to 3.12, METH_FASTCALL since 3.13. The wrapper installed matches. */
+static PyCFunction orig_update = NULL;
+static PyCFunction orig_difference_update = NULL;
+static PyCFunction orig_intersection_update = NULL;
+static int wrappers_installed = 0;
+
+/* ---------- saved original in-place operator slots ---------- */
+static binaryfunc orig_nb_inplace_or = NULL;
+static binaryfunc orig_nb_inplace_and = NULL;
+static binaryfunc orig_nb_inplace_subtract = NULL;
+static binaryfunc orig_nb_inplace_xor = NULL;
 
 /* reentrancy guard (per-thread) to avoid wrapper->hook->wrapper loops */
 static __thread int inprogress = 0;
@@ -32,18 +50,28 @@ patched_set_add(PyObject *self, PyObject *arg)
         return NULL;
     }
 
+    /* with no-op suppression, adding a member is not reported */
+    int present = 0;
+    if (!inprogress && activation_is_active(self)
+            && activation_noop_mode(self) != REAKTOME_NOOP_REPORT) {
+        present = PySequence_Contains(self, arg);
+        if (present < 0) return NULL;
+    }
+
     /* call original (C function pointer saved earlier) */
+    int64_t t0 = REAKTOME_STATS_START();
     res = orig_add(self, arg);
     if (!res) return NULL;
 
     /* guarded advisory call: key = Py_None, old = Py_None, new = arg */
-    if (!inprogress) {
+    if (!present && !inprogress && activation_is_active(self)) {
+        REAKTOME_STATS_OP(self, REAKTOME_OP_ADD, t0);
         inprogress = 1;
-        if (reaktome_call_dunder(self,
-                                 "__reaktome_additem__",
-                                 Py_None,   /* key */
-                                 Py_None,   /* old */
-                                 arg) < 0) {
+        if (reaktome_call_hook(self,
+                               REAKTOME_HOOK_ADDITEM,
+                               Py_None,   /* key */
+                               Py_None,   /* old */
+                               arg) < 0) {
             inprogress = 0;
             Py_DECREF(res);
             return NULL;
@@ -64,16 +92,26 @@ patched_set_discard(PyObject *self, PyObject *arg)
         return NULL;
     }
 
+    /* with no-op suppression, discarding a non-member is not reported */
+    int present = 1;
+    if (!inprogress && activation_is_active(self)
+            && activation_noop_mode(self) != REAKTOME_NOOP_REPORT) {
+        present = PySequence_Contains(self, arg);  /* set args match as frozensets */
+        if (present < 0) return NULL;
+    }
+
+    int64_t t0 = REAKTOME_STATS_START();
     res = orig_discard(self, arg);
     if (!res) return NULL;
 
-    if (!inprogress) {
+    if (present && !inprogress && activation_is_active(self)) {
+        REAKTOME_STATS_OP(self, REAKTOME_OP_DISCARD, t0);
         inprogress = 1;
-        if (reaktome_call_dunder(self,
-                                 "__reaktome_discarditem__",
-                                 Py_None,  /* key */
-                                 arg,      /* old */
-                                 Py_None) < 0) {
+        if (reaktome_call_hook(self,
+                               REAKTOME_HOOK_DISCARDITEM,
+                               Py_None,  /* key */
+                               arg,      /* old */
+                               Py_None) < 0) {
             inprogress = 0;
             Py_DECREF(res);
             return NULL;
@@ -94,16 +132,18 @@ patched_set_remove(PyObject *self, PyObject *arg)
         return NULL;
     }
 
+    int64_t t0 = REAKTOME_STATS_START();
     res = orig_remove(self, arg);
     if (!res) return NULL;
 
-    if (!inprogress) {
+    if (!inprogress && activation_is_active(self)) {
+        REAKTOME_STATS_OP(self, REAKTOME_OP_REMOVE, t0);
         inprogress = 1;
-        if (reaktome_call_dunder(self,
-                                 "__reaktome_discarditem__",
-                                 Py_None,  /* key */
-                                 arg,      /* old */
-                                 Py_None) < 0) {
+        if (reaktome_call_hook(self,
+                               REAKTOME_HOOK_DISCARDITEM,
+                               Py_None,  /* key */
+                               arg,      /* old */
+                               Py_None) < 0) {
             inprogress = 0;
             Py_DECREF(res);
             return NULL;
@@ -114,6 +154,329 @@ patched_set_remove(PyObject *self, PyObject *arg)
     return res;
 }
 
+/* ---------- bulk operations: one (removed, added) delta ----------
+   Observed sets are changed here with PySet_Add/PySet_Discard instead of
+   by the originals, so the delta is known element by element without
+   snapshotting the set: O(size of the arguments), except intersections,
+   which have to visit self. */
+
+static inline void
+call_hook_advisory_set(PyObject *self, reaktome_hook hook,
+                       PyObject *key, PyObject *old, PyObject *newv)
+{
+    if (reaktome_call_hook(self, hook, key, old, newv) < 0) PyErr_Clear();
+}
+
+/* One __reaktome_delta__(self, None, removed, added) call when registered
+   (removed as `old`, added as `new`, like any other hook), else a discarditem per removed and an additem per added element.
+   Nothing is reported for an empty delta. */
+static void
+report_delta(PyObject *self, PyObject *removed, PyObject *added)
+{
+    if (PySet_GET_SIZE(removed) == 0 && PySet_GET_SIZE(added) == 0) return;
+
+    if (activation_has_hook(self, REAKTOME_HOOK_DELTA)) {
+        call_hook_advisory_set(self, REAKTOME_HOOK_DELTA, Py_None, removed, added);
+        return;
+    }
+    /* both sets are private to the operation, so hooks cannot resize them */
+    PyObject *it, *x;
+    if ((it = PyObject_GetIter(removed))) {
+        while ((x = PyIter_Next(it))) {
+            call_hook_advisory_set(self, REAKTOME_HOOK_DISCARDITEM, Py_None, x, Py_None);
+            Py_DECREF(x);
+        }
+        Py_DECREF(it);
+    }
+    if ((it = PyObject_GetIter(added))) {
+        while ((x = PyIter_Next(it))) {
+            call_hook_advisory_set(self, REAKTOME_HOOK_ADDITEM, Py_None, Py_None, x);
+            Py_DECREF(x);
+        }
+        Py_DECREF(it);
+    }
+    PyErr_Clear();
+}
+
+/* Elements of `from` for which PySet_Contains(in, x) == want, into a new set. */
+static PyObject *
+collect(PyObject *from, PyObject *in, int want)
+{
+    PyObject *out = PySet_New(NULL);
+    PyObject *it = out ? PyObject_GetIter(from) : NULL;
+    if (!it) { Py_XDECREF(out); return NULL; }
+    PyObject *x;
+    while ((x = PyIter_Next(it))) {
+        int c = PySequence_Contains(in, x);
+        if (c == want && PySet_Add(out, x) < 0) c = -1;
+        Py_DECREF(x);
+        if (c < 0) { Py_DECREF(it); Py_DECREF(out); return NULL; }
+    }
+    Py_DECREF(it);
+    if (PyErr_Occurred()) { Py_DECREF(out); return NULL; }
+    return out;
+}
+
+/* Apply `op` (PySet_Add or PySet_Discard) to self for each element of
+   batch and record the element in `into`. */
+static int
+apply_batch(PyObject *self, PyObject *batch, PyObject *into,
+            int (*op)(PyObject *, PyObject *))
+{
+    PyObject *it = PyObject_GetIter(batch), *x;
+    if (!it) return -1;
+    while ((x = PyIter_Next(it))) {
+        int rc = op(self, x) < 0 || PySet_Add(into, x) < 0 ? -1 : 0;
+        Py_DECREF(x);
+        if (rc < 0) { Py_DECREF(it); return -1; }
+    }
+    Py_DECREF(it);
+    return PyErr_Occurred() ? -1 : 0;
+}
+
+/* Elements are applied as they arrive (one-shot iterators stay one-shot);
+   an error part way leaves the earlier ones applied and reported. */
+static int
+bulk_update(PyObject *self, PyObject *const *others, Py_ssize_t n, PyObject *added)
+{
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *it = PyObject_GetIter(others[i]), *x;
+        if (!it) return -1;
+        while ((x = PyIter_Next(it))) {
+            int c = PySet_Contains(self, x);
+            if (c == 0) c = PySet_Add(self, x) < 0 || PySet_Add(added, x) < 0 ? -1 : 0;
+            Py_DECREF(x);
+            if (c < 0) { Py_DECREF(it); return -1; }
+        }
+        Py_DECREF(it);
+        if (PyErr_Occurred()) return -1;
+    }
+    return 0;
+}
+
+static int
+bulk_difference_update(PyObject *self, PyObject *const *others, Py_ssize_t n,
+                       PyObject *removed)
+{
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *other = others[i];
+        /* walk whichever side is smaller when both can be probed */
+        int probe_other = (PyAnySet_Check(other) || PyDict_CheckExact(other))
+                          && PyObject_Size(other) > PySet_GET_SIZE(self);
+        PyObject *batch = probe_other ? collect(self, other, 1)
+                                      : collect(other, self, 1);
+        if (!batch) return -1;
+        int rc = apply_batch(self, batch, removed, PySet_Discard);
+        Py_DECREF(batch);
+        if (rc < 0) return -1;
+    }
+    return 0;
+}
+
+static int
+bulk_intersection_update(PyObject *self, PyObject *const *others, Py_ssize_t n,
+                         PyObject *removed)
+{
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *other = others[i], *batch;
+        if (PyAnySet_Check(other) || PyDict_CheckExact(other)) {
+            batch = collect(self, other, 0);
+        } else {
+            /* keep what the iterable yields, drop the rest */
+            PyObject *keep = collect(other, self, 1);
+            if (!keep) return -1;
+            batch = collect(self, keep, 0);
+            Py_DECREF(keep);
+        }
+        if (!batch) return -1;
+        int rc = apply_batch(self, batch, removed, PySet_Discard);
+        Py_DECREF(batch);
+        if (rc < 0) return -1;
+    }
+    return 0;
+}
+
+static int
+bulk_symmetric_difference_update(PyObject *self, PyObject *other,
+                                 PyObject *removed, PyObject *added)
+{
+    /* like set_symmetric_difference_update: duplicates in an iterable
+       count once, and s ^= s empties s */
+    PyObject *o = (PyAnySet_Check(other) && other != self) || PyDict_CheckExact(other)
+                  ? Py_NewRef(other) : PySet_New(other);
+    if (!o) return -1;
+    PyObject *it = PyObject_GetIter(o), *x;
+    if (!it) { Py_DECREF(o); return -1; }
+    int rc = 0;
+    while (rc == 0 && (x = PyIter_Next(it))) {
+        int c = PySet_Contains(self, x);
+        if (c == 1)
+            rc = PySet_Discard(self, x) < 0 || PySet_Add(removed, x) < 0 ? -1 : 0;
+        else if (c == 0)
+            rc = PySet_Add(self, x) < 0 || PySet_Add(added, x) < 0 ? -1 : 0;
+        else
+            rc = -1;
+        Py_DECREF(x);
+    }
+    Py_DECREF(it);
+    Py_DECREF(o);
+    return rc < 0 || PyErr_Occurred() ? -1 : 0;
+}
+
+/* Which bulk operation run_bulk performs. */
+typedef enum {
+    BULK_UPDATE,
+    BULK_DIFFERENCE_UPDATE,
+    BULK_INTERSECTION_UPDATE,
+    BULK_SYMMETRIC_DIFFERENCE_UPDATE,
+} bulk_kind;
+
+static const reaktome_op bulk_ops[] = {
+    REAKTOME_OP_UPDATE,
+    REAKTOME_OP_DIFFERENCE_UPDATE,
+    REAKTOME_OP_INTERSECTION_UPDATE,
+    REAKTOME_OP_SYMMETRIC_DIFFERENCE_UPDATE,
+};
+
+/* Run a bulk operation on an observed set and report its delta, even when
+   it failed part way. Returns 0, or -1 with the operation's exception. */
+static int
+run_bulk(PyObject *self, bulk_kind kind, PyObject *const *others, Py_ssize_t n)
+{
+    PyObject *removed = PySet_New(NULL);
+    PyObject *added = removed ? PySet_New(NULL) : NULL;
+    if (!added) { Py_XDECREF(removed); return -1; }
+
+    /* hold self: a hook may deactivate it */
+    Py_INCREF(self);
+    int64_t t0 = REAKTOME_STATS_START();
+    int rc;
+    switch (kind) {
+    case BULK_UPDATE:
+        rc = bulk_update(self, others, n, added);
+        break;
+    case BULK_DIFFERENCE_UPDATE:
+        rc = bulk_difference_update(self, others, n, removed);
+        break;
+    case BULK_INTERSECTION_UPDATE:
+        rc = bulk_intersection_update(self, others, n, removed);
+        break;
+    default:
+        rc = bulk_symmetric_difference_update(self, others[0], removed, added);
+        break;
+    }
+    REAKTOME_STATS_OP(self, bulk_ops[kind], t0);
+
+    PyObject *exc = PyErr_GetRaisedException();
+    inprogress = 1;
+    report_delta(self, removed, added);
+    inprogress = 0;
+    PyErr_SetRaisedException(exc);
+
+    Py_DECREF(removed);
+    Py_DECREF(added);
+    Py_DECREF(self);
+    return rc;
+}
+
+static inline int
+observed(PyObject *self)
+{
+    return !inprogress && activation_is_active(self);
+}
+
+/* update / difference_update / intersection_update: one wrapper per
+   calling convention, picked at install time from the original's flags */
+#define VARIADIC_WRAPPERS(name, kind)                                          \
+static PyObject *                                                             \
+patched_set_##name(PyObject *self, PyObject *args)                             \
+{                                                                             \
+    if (!observed(self)) return orig_##name(self, args);                     \
+    if (run_bulk(self, kind, ((PyTupleObject *)args)->ob_item,                \
+                 PyTuple_GET_SIZE(args)) < 0) return NULL;                    \
+    Py_RETURN_NONE;                                                           \
+}                                                                             \
+static PyObject *                                                             \
+patched_set_##name##_fast(PyObject *self, PyObject *const *args, Py_ssize_t n) \
+{                                                                             \
+    if (!observed(self))                                                      \
+        return ((PyObject *(*)(PyObject *, PyObject *const *, Py_ssize_t))   \
+                (void (*)(void))orig_##name)(self, args, n);                  \
+    if (run_bulk(self, kind, args, n) < 0) return NULL;                       \
+    Py_RETURN_NONE;                                                           \
+}
+
+VARIADIC_WRAPPERS(update, BULK_UPDATE)
+VARIADIC_WRAPPERS(difference_update, BULK_DIFFERENCE_UPDATE)
+VARIADIC_WRAPPERS(intersection_update, BULK_INTERSECTION_UPDATE)
+
+static PyObject *
+patched_set_symmetric_difference_update(PyObject *self, PyObject *other)
+{
+    if (!observed(self)) return orig_symmetric_difference_update(self, other);
+    if (run_bulk(self, BULK_SYMMETRIC_DIFFERENCE_UPDATE, &other, 1) < 0) return NULL;
+    Py_RETURN_NONE;
+}
+
+/* pop(): a single discarditem, like discard */
+static PyObject *
+patched_set_pop(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    int64_t t0 = REAKTOME_STATS_START();
+    PyObject *res = orig_pop(self, NULL);
+    if (!res || !observed(self)) return res;
+    REAKTOME_STATS_OP(self, REAKTOME_OP_POP, t0);
+    inprogress = 1;
+    call_hook_advisory_set(self, REAKTOME_HOOK_DISCARDITEM, Py_None, res, Py_None);
+    inprogress = 0;
+    return res;
+}
+
+/* clear(): a copy of the old contents goes to __reaktome_clear__(self, None,
+   old, None) when registered, else it is reported as a delta. The set's
+   table may be inline in the object, so it cannot be handed over. */
+static PyObject *
+patched_set_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (!observed(self) || PySet_GET_SIZE(self) == 0) return orig_clear(self, NULL);
+
+    PyObject *old = PySet_New(self);
+    if (!old) return NULL;
+    int64_t t0 = REAKTOME_STATS_START();
+    PySet_Clear(self);
+    REAKTOME_STATS_OP(self, REAKTOME_OP_CLEAR, t0);
+
+    inprogress = 1;
+    if (activation_has_hook(self, REAKTOME_HOOK_CLEAR)) {
+        call_hook_advisory_set(self, REAKTOME_HOOK_CLEAR, Py_None, old, Py_None);
+    } else {
+        PyObject *none = PySet_New(NULL);
+        if (none) report_delta(self, old, none);
+        else PyErr_Clear();
+        Py_XDECREF(none);
+    }
+    inprogress = 0;
+    Py_DECREF(old);
+    Py_RETURN_NONE;
+}
+
+/* ---------- slot trampolines: |=, &=, -=, ^= ---------- */
+/* The originals return NotImplemented unless both sides are sets. */
+#define INPLACE_TRAMPOLINE(slot, kind)                                        \
+static PyObject *                                                             \
+tramp_##slot(PyObject *self, PyObject *other)                                 \
+{                                                                             \
+    if (!PyAnySet_Check(self) || !PyAnySet_Check(other) || !observed(self))   \
+        return orig_##slot(self, other);                                      \
+    if (run_bulk(self, kind, &other, 1) < 0) return NULL;                     \
+    return Py_NewRef(self);                                                   \
+}
+
+INPLACE_TRAMPOLINE(nb_inplace_or, BULK_UPDATE)
+INPLACE_TRAMPOLINE(nb_inplace_and, BULK_INTERSECTION_UPDATE)
+INPLACE_TRAMPOLINE(nb_inplace_subtract, BULK_DIFFERENCE_UPDATE)
+INPLACE_TRAMPOLINE(nb_inplace_xor, BULK_SYMMETRIC_DIFFERENCE_UPDATE)
+
 /* ---------- helpers to find method entries by name in a type's tp_methods ---------- */
 
 static PyMethodDef *
@@ -127,6 +490,147 @@ find_methoddef(PyTypeObject *tp, const char *name)
     return NULL;
 }
 
+/* ---------- the methods we wrap ---------- */
+typedef struct {
+    const char *name;
+    PyCFunction *orig;      /* where the original ml_meth is saved */
+    PyCFunction wrapper;    /* for the original's calling convention */
+    PyCFunction fast;       /* METH_FASTCALL variant, or NULL */
+} wrapped_method;
+
+#define FAST(fn) ((PyCFunction)(void (*)(void))(fn))
+
+static const wrapped_method wrapped_methods[] = {
+    {"add", &orig_add, (PyCFunction)patched_set_add, NULL},
+    {"discard", &orig_discard, (PyCFunction)patched_set_discard, NULL},
+    {"remove", &orig_remove, (PyCFunction)patched_set_remove, NULL},
+    {"pop", &orig_pop, (PyCFunction)patched_set_pop, NULL},
+    {"clear", &orig_clear, (PyCFunction)patched_set_clear, NULL},
+    {"symmetric_difference_update", &orig_symmetric_difference_update,
+     (PyCFunction)patched_set_symmetric_difference_update, NULL},
+    {"update", &orig_update, (PyCFunction)patched_set_update,
+     FAST(patched_set_update_fast)},
+    {"difference_update", &orig_difference_update,
+     (PyCFunction)patched_set_difference_update,
+     FAST(patched_set_difference_update_fast)},
+    {"intersection_update", &orig_intersection_update,
+     (PyCFunction)patched_set_intersection_update,
+     FAST(patched_set_intersection_update_fast)},
+    {NULL, NULL, NULL, NULL}
+};
+
+/* ---------- uninstall: put the original ml_meth pointers back ---------- */
+
+/* Runs once the last activated set is gone (or on unpatch_all). The orig_*
+   pointers stay set for calls already inside a wrapper. */
+static void
+uninstall_set(PyTypeObject *Py_UNUSED(install))
+{
+    if (!wrappers_installed) return;
+
+    for (const wrapped_method *w = wrapped_methods; w->name; w++) {
+        PyMethodDef *m = find_methoddef(&PySet_Type, w->name);
+        if (m) m->ml_meth = *w->orig;
+    }
+    PyNumberMethods *nb = PySet_Type.tp_as_number;
+    nb->nb_inplace_or = orig_nb_inplace_or;
+    nb->nb_inplace_and = orig_nb_inplace_and;
+    nb->nb_inplace_subtract = orig_nb_inplace_subtract;
+    nb->nb_inplace_xor = orig_nb_inplace_xor;
+    wrappers_installed = 0;
+
+    PyType_Modified(&PySet_Type);
+}
+
+/* ---------- native subclass: ReaktomeSet ----------
+   A set subclass with its own method table pointing at the wrappers above
+   (same names and flags as set's), the in-place operator trampolines, and
+   its activation entry in the object. The originals start at PySet_Type's
+   own (see reaktome_patch_set). */
+
+typedef struct {
+    PySetObject set;
+    reaktome_entry entry;
+} reaktome_set;
+
+static void
+native_set_dealloc(PyObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    activation_merge(self, Py_None);
+    PySet_Type.tp_dealloc(self);
+}
+
+static int
+native_set_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(((reaktome_set *)self)->entry.hooks.dunders);
+    return PySet_Type.tp_traverse(self, visit, arg);
+}
+
+static int
+native_set_clear(PyObject *self)
+{
+    activation_merge(self, Py_None);
+    return PySet_Type.tp_clear(self);
+}
+
+static PyNumberMethods native_set_as_number = {
+    .nb_inplace_or = tramp_nb_inplace_or,
+    .nb_inplace_and = tramp_nb_inplace_and,
+    .nb_inplace_subtract = tramp_nb_inplace_subtract,
+    .nb_inplace_xor = tramp_nb_inplace_xor,
+};
+
+#define N_WRAPPED (sizeof(wrapped_methods) / sizeof(wrapped_methods[0]))
+
+/* Filled from wrapped_methods at module init */
+static PyMethodDef native_set_methods[N_WRAPPED];
+
+static PyTypeObject ReaktomeSet_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "_reaktome.ReaktomeSet",
+    .tp_basicsize = sizeof(reaktome_set),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "set with its reaktome hooks built in",
+    .tp_dealloc = native_set_dealloc,
+    .tp_traverse = native_set_traverse,
+    .tp_clear = native_set_clear,
+    .tp_as_number = &native_set_as_number,
+    .tp_methods = native_set_methods,
+};
+
+/* Save PySet_Type's own methods and slots as the originals, unless an
+   install already did, then ready and register ReaktomeSet. */
+static int
+native_set_init(PyObject *m)
+{
+    size_t i = 0;
+    for (const wrapped_method *w = wrapped_methods; w->name; w++, i++) {
+        PyMethodDef *def = find_methoddef(&PySet_Type, w->name);
+        if (!def) {
+            PyErr_Format(PyExc_RuntimeError, "failed to locate set.%s", w->name);
+            return -1;
+        }
+        if (!*w->orig) *w->orig = def->ml_meth;
+        native_set_methods[i] = *def;
+        native_set_methods[i].ml_meth =
+            (w->fast && (def->ml_flags & METH_FASTCALL)) ? w->fast : w->wrapper;
+    }
+
+    PyNumberMethods *nb = PySet_Type.tp_as_number;
+    if (!orig_nb_inplace_or) orig_nb_inplace_or = nb->nb_inplace_or;
+    if (!orig_nb_inplace_and) orig_nb_inplace_and = nb->nb_inplace_and;
+    if (!orig_nb_inplace_subtract) orig_nb_inplace_subtract = nb->nb_inplace_subtract;
+    if (!orig_nb_inplace_xor) orig_nb_inplace_xor = nb->nb_inplace_xor;
+
+    ReaktomeSet_Type.tp_base = &PySet_Type;
+    if (PyType_Ready(&ReaktomeSet_Type) < 0) return -1;
+    if (activation_register_inline(&ReaktomeSet_Type,
+                                   offsetof(reaktome_set, entry)) < 0) return -1;
+    return PyModule_AddObjectRef(m, "ReaktomeSet", (PyObject *)&ReaktomeSet_Type);
+}
+
 /* ---------- Python-callable: py_patch_set(target, dunders) ---------- */
 
 static PyObject *
@@ -143,37 +647,62 @@ py_patch_set(PyObject *self, PyObject *args)
         return NULL;
     }
 
+    /* ReaktomeSet has the wrappers built in */
+    if (activation_is_inline(target)) {
+        if (activation_merge(target, dunders) < 0) return NULL;
+        Py_RETURN_NONE;
+    }
+
+    /* Clearing never installs anything; it may uninstall */
+    if (dunders == Py_None) {
+        if (activation_merge_installed(target, Py_None, &PySet_Type) < 0) return NULL;
+        Py_RETURN_NONE;
+    }
+
     /* Ensure the type is initialized (should be) */
     PyTypeObject *tp = Py_TYPE(target);
     if (PyType_Ready(tp) < 0) return NULL;
 
-    /* Install wrappers once: save original ml_meth pointers and replace them */
-    if (!orig_add || !orig_discard || !orig_remove) {
-        PyMethodDef *m_add = find_methoddef(&PySet_Type, "add");
-        PyMethodDef *m_discard = find_methoddef(&PySet_Type, "discard");
-        PyMethodDef *m_remove = find_methoddef(&PySet_Type, "remove");
+    /* Evict side-table entries when sets (and set subclasses) die */
+    if (activation_evict_on_dealloc(&PySet_Type) < 0) return NULL;
 
-        if (!m_add || !m_discard || !m_remove) {
-            PyErr_SetString(PyExc_RuntimeError, "patch_set: failed to locate set methods");
-            return NULL;
+    /* Install wrappers once: save original ml_meth pointers and replace them */
+    if (!wrappers_installed) {
+        for (const wrapped_method *w = wrapped_methods; w->name; w++) {
+            if (!find_methoddef(&PySet_Type, w->name)) {
+                PyErr_Format(PyExc_RuntimeError,
+                             "patch_set: failed to locate set.%s", w->name);
+                return NULL;
+            }
         }
 
-        /* save originals */
-        orig_add = m_add->ml_meth;
-        orig_discard = m_discard->ml_meth;
-        orig_remove = m_remove->ml_meth;
+        /* save originals and replace them with our wrappers */
+        for (const wrapped_method *w = wrapped_methods; w->name; w++) {
+            PyMethodDef *m = find_methoddef(&PySet_Type, w->name);
+            *w->orig = m->ml_meth;
+            m->ml_meth = (w->fast && (m->ml_flags & METH_FASTCALL)) ? w->fast : w->wrapper;
+        }
 
-        /* replace with our wrappers */
-        m_add->ml_meth = (PyCFunction)patched_set_add;
-        m_discard->ml_meth = (PyCFunction)patched_set_discard;
-        m_remove->ml_meth = (PyCFunction)patched_set_remove;
+        PyNumberMethods *nb = PySet_Type.tp_as_number;
+        orig_nb_inplace_or = nb->nb_inplace_or;
+        orig_nb_inplace_and = nb->nb_inplace_and;
+        orig_nb_inplace_subtract = nb->nb_inplace_subtract;
+        orig_nb_inplace_xor = nb->nb_inplace_xor;
+        nb->nb_inplace_or = tramp_nb_inplace_or;
+        nb->nb_inplace_and = tramp_nb_inplace_and;
+        nb->nb_inplace_subtract = tramp_nb_inplace_subtract;
+        nb->nb_inplace_xor = tramp_nb_inplace_xor;
+        wrappers_installed = 1;
 
         /* inform runtime that type dict changed (best-effort) */
         PyType_Modified(&PySet_Type);
     }
 
-    /* Merge hooks for this instance (activation side-table). dunders may be None to clear. */
-    if (activation_merge(target, dunders) < 0) return NULL;
+    /* Every set activation holds this install; see uninstall_set */
+    if (activation_install(&PySet_Type, uninstall_set) < 0) return NULL;
+
+    /* Merge hooks for this instance (activation side-table). */
+    if (activation_merge_installed(target, dunders, &PySet_Type) < 0) return NULL;
 
     Py_RETURN_NONE;
 }
@@ -190,5 +719,6 @@ reaktome_patch_set(PyObject *m)
 {
     if (!m) return -1;
     if (PyModule_AddFunctions(m, set_methods) < 0) return -1;
+    if (native_set_init(m) < 0) return -1;
     return 0;
 }
@@ -0,0 +1,215 @@
+/* src/stats.c
+   Opt-in statistics for trampolines and hook calls (see stats.h).
+   Cells live in a per-type record found through a pointer table, so a
+   sample costs one probe and a few integer updates. The record holds a
+   strong reference to its type until reset, so an address cannot be
+   reused by another type while it is being reported. */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <string.h>
+#include "stats.h"
+#include "ptr_table.h"
+
+int reaktome_stats_enabled = 0;
+
+typedef struct {
+    uint64_t count;   /* ops performed / hook calls */
+    uint64_t errors;  /* hooks only: calls that raised */
+    uint64_t ns;      /* cumulative time */
+    uint64_t hist[REAKTOME_STATS_BUCKETS];
+} stats_cell;
+
+typedef struct {
+    stats_cell ops[REAKTOME_OP_COUNT];
+    stats_cell hooks[REAKTOME_HOOK_COUNT];
+} type_stats;
+
+/* Indexed by reaktome_op */
+static const char *const op_names[REAKTOME_OP_COUNT] = {
+    "setitem",
+    "delitem",
+    "setslice",
+    "append",
+    "extend",
+    "insert",
+    "pop",
+    "remove",
+    "clear",
+    "sort",
+    "reverse",
+    "iadd",
+    "imul",
+    "update",
+    "popitem",
+    "setdefault",
+    "add",
+    "discard",
+    "difference_update",
+    "intersection_update",
+    "symmetric_difference_update",
+    "setattr",
+    "delattr",
+};
+
+/* PyTypeObject* -> type_stats* */
+static ptr_table stats_types;
+
+static type_stats *
+stats_for(PyTypeObject *tp)
+{
+    ptr_entry *e = ptr_table_find(&stats_types, tp);
+    if (e) return (type_stats *)e->value;
+
+    type_stats *ts = PyMem_Calloc(1, sizeof(type_stats));
+    if (!ts) return NULL;
+
+    /* samples are best-effort: never clobber the caller's exception */
+    PyObject *exc = PyErr_GetRaisedException();
+    if (!ptr_table_insert(&stats_types, tp, ts)) {
+        PyMem_Free(ts);
+        ts = NULL;
+        PyErr_Clear();
+    } else {
+        Py_INCREF(tp);
+    }
+    PyErr_SetRaisedException(exc);
+    return ts;
+}
+
+static inline int
+bucket_for(uint64_t ns)
+{
+    if (ns < 256) return 0;
+    int b = 63 - __builtin_clzll(ns) - 7;
+    return b < REAKTOME_STATS_BUCKETS ? b : REAKTOME_STATS_BUCKETS - 1;
+}
+
+static inline void
+cell_add(stats_cell *cell, int64_t dt)
+{
+    uint64_t ns = dt > 0 ? (uint64_t)dt : 0;
+    cell->count++;
+    cell->ns += ns;
+    cell->hist[bucket_for(ns)]++;
+}
+
+void
+reaktome_stats_record_op(PyObject *self, reaktome_op op, int64_t ns)
+{
+    type_stats *ts = stats_for(Py_TYPE(self));
+    if (ts) cell_add(&ts->ops[op], ns);
+}
+
+void
+reaktome_stats_record_hook(PyObject *self, reaktome_hook hook,
+                           int64_t t0, int failed)
+{
+    int64_t ns = reaktome_stats_clock() - t0;
+    type_stats *ts = stats_for(Py_TYPE(self));
+    if (!ts) return;
+    cell_add(&ts->hooks[hook], ns);
+    if (failed) ts->hooks[hook].errors++;
+}
+
+/* {"count": n, ["errors": n,] "ns": n, "hist": [...]} */
+static PyObject *
+cell_to_dict(const stats_cell *cell, const char *count_name, int with_errors)
+{
+    PyObject *hist = PyList_New(REAKTOME_STATS_BUCKETS);
+    if (!hist) return NULL;
+    for (int i = 0; i < REAKTOME_STATS_BUCKETS; i++) {
+        PyObject *n = PyLong_FromUnsignedLongLong(cell->hist[i]);
+        if (!n) {
+            Py_DECREF(hist);
+            return NULL;
+        }
+        PyList_SET_ITEM(hist, i, n);
+    }
+
+    PyObject *d = with_errors
+        ? Py_BuildValue("{sKsKsKsN}", count_name, cell->count,
+                        "errors", cell->errors, "ns", cell->ns, "hist", hist)
+        : Py_BuildValue("{sKsKsN}", count_name, cell->count,
+                        "ns", cell->ns, "hist", hist);
+    return d;
+}
+
+/* Add one entry per non-empty cell to a new dict stored under `key`. */
+static int
+cells_into(PyObject *out, const char *key, const stats_cell *cells, int n,
+           const char *(*name_of)(int), const char *count_name, int with_errors)
+{
+    PyObject *d = PyDict_New();
+    if (!d) return -1;
+    for (int i = 0; i < n; i++) {
+        if (!cells[i].count) continue;
+        PyObject *cell = cell_to_dict(&cells[i], count_name, with_errors);
+        if (!cell || PyDict_SetItemString(d, name_of(i), cell) < 0) {
+            Py_XDECREF(cell);
+            Py_DECREF(d);
+            return -1;
+        }
+        Py_DECREF(cell);
+    }
+    int rc = PyDict_SetItemString(out, key, d);
+    Py_DECREF(d);
+    return rc;
+}
+
+static const char *
+op_name(int op)
+{
+    return op_names[op];
+}
+
+static const char *
+hook_name(int hook)
+{
+    return activation_hook_name((reaktome_hook)hook);
+}
+
+PyObject *
+reaktome_stats_snapshot(void)
+{
+    PyObject *result = PyDict_New();
+    if (!result) return NULL;
+
+    for (size_t j = 0; stats_types.used && j <= stats_types.mask; j++) {
+        ptr_entry *e = &stats_types.entries[j];
+        if (!e->key || e->key == PTR_TABLE_TOMBSTONE) continue;
+        const type_stats *ts = e->value;
+
+        PyObject *per = PyDict_New();
+        if (!per) goto fail;
+        if (cells_into(per, "ops", ts->ops, REAKTOME_OP_COUNT,
+                       op_name, "count", 0) < 0 ||
+            cells_into(per, "hooks", ts->hooks, REAKTOME_HOOK_COUNT,
+                       hook_name, "calls", 1) < 0 ||
+            PyDict_SetItem(result, (PyObject *)e->key, per) < 0) {
+            Py_DECREF(per);
+            goto fail;
+        }
+        Py_DECREF(per);
+    }
+    return result;
+
+fail:
+    Py_DECREF(result);
+    return NULL;
+}
+
+void
+reaktome_stats_reset(void)
+{
+    ptr_table old = stats_types;
+    memset(&stats_types, 0, sizeof(stats_types));
+
+    for (size_t j = 0; old.used && j <= old.mask; j++) {
+        ptr_entry *e = &old.entries[j];
+        if (!e->key || e->key == PTR_TABLE_TOMBSTONE) continue;
+        PyMem_Free(e->value);
+        Py_DECREF((PyObject *)e->key);
+    }
+    PyMem_Free(old.entries);
+}
@@ -0,0 +1,91 @@
+#ifndef REAKTOME_STATS_H
+#define REAKTOME_STATS_H
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+#include <time.h>
+#include "activation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opt-in instrumentation. While disabled, trampolines pay one predictable
+   branch on the observed path and nothing on the unobserved fast path.
+   When enabled, each trampoline running for an active instance records
+   the time spent in the original operation, and every hook call records
+   its own time and whether it raised, per type. */
+
+/* Mutations timed by the trampolines. */
+typedef enum {
+    REAKTOME_OP_SETITEM,
+    REAKTOME_OP_DELITEM,
+    REAKTOME_OP_SETSLICE,
+    REAKTOME_OP_APPEND,
+    REAKTOME_OP_EXTEND,
+    REAKTOME_OP_INSERT,
+    REAKTOME_OP_POP,
+    REAKTOME_OP_REMOVE,
+    REAKTOME_OP_CLEAR,
+    REAKTOME_OP_SORT,
+    REAKTOME_OP_REVERSE,
+    REAKTOME_OP_IADD,
+    REAKTOME_OP_IMUL,
+    REAKTOME_OP_UPDATE,
+    REAKTOME_OP_POPITEM,
+    REAKTOME_OP_SETDEFAULT,
+    REAKTOME_OP_ADD,
+    REAKTOME_OP_DISCARD,
+    REAKTOME_OP_DIFFERENCE_UPDATE,
+    REAKTOME_OP_INTERSECTION_UPDATE,
+    REAKTOME_OP_SYMMETRIC_DIFFERENCE_UPDATE,
+    REAKTOME_OP_SETATTR,
+    REAKTOME_OP_DELATTR,
+    REAKTOME_OP_COUNT
+} reaktome_op;
+
+/* Histogram buckets: bucket 0 counts durations below 256ns, bucket i
+   [2^(i+7), 2^(i+8)) ns, and the last one everything from ~4ms up. */
+#define REAKTOME_STATS_BUCKETS 16
+
+extern int reaktome_stats_enabled;
+
+static inline int64_t
+reaktome_stats_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Start timestamp for REAKTOME_STATS_OP, or 0 while disabled. */
+#define REAKTOME_STATS_START() \
+    (reaktome_stats_enabled ? reaktome_stats_clock() : 0)
+
+/* Record one `op` on self that started at t0 (from REAKTOME_STATS_START). */
+#define REAKTOME_STATS_OP(self, op, t0)                                   \
+    do {                                                                  \
+        if ((t0) && reaktome_stats_enabled)                               \
+            reaktome_stats_record_op((self), (op),                        \
+                                     reaktome_stats_clock() - (t0));      \
+    } while (0)
+
+void reaktome_stats_record_op(PyObject *self, reaktome_op op, int64_t ns);
+
+/* Record one call of `hook` on self that started at t0; failed is non-zero
+   when the hook raised. Never touches the current exception. */
+void reaktome_stats_record_hook(PyObject *self, reaktome_hook hook,
+                                int64_t t0, int failed);
+
+/* {type: {"ops": {name: {...}}, "hooks": {name: {...}}}}; new reference. */
+PyObject *reaktome_stats_snapshot(void);
+
+/* Forget everything recorded so far. */
+void reaktome_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REAKTOME_STATS_H */
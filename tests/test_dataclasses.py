@@ -6,7 +6,7 @@ from typing import Any
 from unittest.mock import MagicMock
 from dataclasses import dataclass
 
-from reaktome import Reaktome, reaktiv8
+from reaktome import Reaktome, Changes, reaktiv8
 
 
 @dataclass
@@ -15,6 +15,12 @@ class Foo(Reaktome):
     name: str
 
 
+@dataclass(slots=True)
+class Slotted(Reaktome):
+    id: str
+    foo: Foo
+
+
 class ReaktomeTestCase(unittest.TestCase):
     def setUp(self):
         self.foo = Foo(id='bac123', name='foo')
@@ -24,3 +30,12 @@ class ReaktomeTestCase(unittest.TestCase):
 
     def test_deepcopy(self):
         deepcopy(self.foo)
+
+    def test_slots_dataclass(self):
+        slotted = Slotted(id='s1', foo=self.foo)
+        self.assertFalse(hasattr(slotted, '__dict__'))
+        changes = []
+        Changes.on(slotted, changes.append)
+        slotted.id = 's2'
+        slotted.foo.name = 'baz'
+        self.assertEqual(['id', 'foo.name'], [c.key for c in changes])
@@ -1,12 +1,22 @@
+import gc
+import subprocess
+import sys
 import unittest
 
 from copy import deepcopy
+from operator import setitem
+
+import _reaktome as _r  # type: ignore
 
 from reaktome import reaktiv8, Changes
 
 
 class ReaktomeDictTestCase(unittest.TestCase):
+    backend = "trampolines"
+    hooks_after_change = True
+
     def setUp(self):
+        self.addCleanup(_r.dict_backend, _r.dict_backend(self.backend))
         self.d = {}
         self.changes = []
         reaktiv8(self.d)
@@ -54,5 +64,210 @@ class ReaktomeDictTestCase(unittest.TestCase):
         # expect 3 hooks, one per removed key
         self.assertEqual(len(self.changes), 3)
 
+    def test_pop_and_setdefault_trigger_hooks(self):
+        self.d["a"] = 1
+        self.changes.clear()
+        self.assertEqual(1, self.d.pop("a"))
+        self.assertEqual(0, self.d.pop("a", 0))
+        with self.assertRaises(KeyError):
+            self.d.pop(("t", 1))
+        self.assertEqual(2, self.d.setdefault("b", 2))
+        self.assertEqual(2, self.d.setdefault("b", 3))
+        self.assertEqual(
+            [(1, None), (None, 2)],
+            [(c.old, c.new) for c in self.changes],
+        )
+
+    def test_update_single_pass(self):
+        self.d["a"] = 1
+        self.changes.clear()
+        # a generator can only be walked once
+        self.d.update((k, v) for k, v in [("a", 2), ("b", 3)])
+        self.d.update({"a": 2}, b=3)  # unchanged, not reported
+        self.assertEqual({"a": 2, "b": 3}, self.d)
+        self.assertEqual(
+            [(1, 2), (None, 3)],
+            [(c.old, c.new) for c in self.changes],
+        )
+        with self.assertRaises(ValueError):
+            self.d.update([("c", 4), ("d",)])
+        self.assertEqual(4, self.d["c"])
+
+    def test_update_hook(self):
+        d, calls = {"a": 1}, []
+        _r.patch_dict(d, {
+            "__reaktome_update__":
+                lambda self, key, old, new: calls.append(new),
+            "__reaktome_setitem__":
+                lambda self, key, old, new: calls.append("setitem"),
+        })
+        d.update([("a", 1), ("a", 2), ("b", 3)])
+        self.assertEqual([[("a", 1, 2), ("b", None, 3)]], calls)
+        _r.patch_dict(d, None)
+
+    def test_clear_hook(self):
+        class Point:
+            pass
+        calls = []
+        d, point = {"a": 1}, Point()
+        point.x = 2
+        for target in (d, point.__dict__):
+            _r.patch_dict(target, {
+                "__reaktome_clear__": lambda *args: calls.append(args),
+            })
+            target.clear()
+            self.assertEqual({}, target)
+        self.assertEqual([
+            (d, None, {"a": 1}, None),
+            (point.__dict__, None, {"x": 2}, None),
+        ], calls)
+        point.y = 3
+        self.assertEqual({"y": 3}, vars(point))
+        for target in (d, point.__dict__):
+            _r.patch_dict(target, None)
+
+    def test_skip_noop_by_equality(self):
+        _r.patch_dict(self.d, {"__reaktome_skip_noop__": "equality"})
+        self.d["a"] = 1
+        setitem(self.d, "a", 1.0)
+        self.d.update(a=True)
+        # equal values are still stored, just not reported
+        self.assertIs(True, self.d["a"])
+        self.assertEqual([(None, 1)], [(c.old, c.new) for c in self.changes])
+
+    def test_key_filter(self):
+        _r.patch_dict(self.d, {"__reaktome_filter__": frozenset({"a", "b"})})
+        self.d["a"] = 1
+        self.d["c"] = 2
+        self.d.update(b=3, d=4)
+        del self.d["c"]
+        self.d.pop("d")
+        self.assertEqual({"a": 1, "b": 3}, self.d)
+        self.assertEqual(["a", "b"], [c.key for c in self.changes])
+
+    def test_bad_key_filter(self):
+        with self.assertRaises(TypeError):
+            _r.patch_dict({}, {"__reaktome_filter__": 1})
+
+    def test_failed_merge_keeps_settings(self):
+        _r.patch_dict(self.d, {"__reaktome_filter__": ["a"]})
+        with self.assertRaises(ValueError):
+            _r.patch_dict(self.d, {"__reaktome_filter__": ["b"],
+                                   "__reaktome_skip_noop__": "bogus"})
+        self.d["a"] = 1
+        self.d["b"] = 2
+        self.assertEqual(["a"], [c.key for c in self.changes])
+
+    def test_subclass_installs_released_with_type(self):
+        # self.d keeps dict's own install alive throughout
+        calls = []
+        hooks = {"__reaktome_setitem__": lambda *args: calls.append(args[1])}
+        for i in range(50):
+            sub = type("D", (dict,), {})()
+            _r.patch_dict(sub, hooks)
+            sub[i] = 1
+            del sub
+            gc.collect()
+        self.assertEqual(list(range(50)), calls)
+        _r.patch_dict(self.d, None)
+        self.d["a"] = 1
+        self.assertEqual([], self.changes)
+
+    def test_default_backend(self):
+        out = subprocess.run(
+            [sys.executable, "-c",
+             "import _reaktome; print(_reaktome.dict_backend())"],
+            capture_output=True, text=True, check=True,
+        ).stdout
+        self.assertEqual("trampolines", out.strip())
+
+    def test_hook_ordering_and_write_back(self):
+        d, seen = {"a": "q"}, []
+
+        def upper(self, key, old, new):
+            seen.append(dict(self))
+            if new.islower():
+                self[key] = new.upper()
+
+        _r.patch_dict(d, {"__reaktome_setitem__": upper})
+        d["a"] = "x"
+        if self.hooks_after_change:
+            self.assertEqual({"a": "x"}, seen[0])
+            self.assertEqual({"a": "X"}, d)
+        else:
+            # the store that follows the hook wins
+            self.assertEqual({"a": "q"}, seen[0])
+            self.assertEqual({"a": "x"}, d)
+
     def test_deepcopy(self):
         deepcopy(self.d)
+
+    def test_installs_what_hooks_need(self):
+        _r.unpatch_all()
+        _r.dict_backend("trampolines")
+        first, second = {}, {}
+        _r.patch_dict(first, {"__reaktome_delitem__": lambda *args: None})
+        self.assertIn("trampoline", dict.pop.__doc__)
+        self.assertNotIn("trampoline", dict.update.__doc__)
+        # installs are the union of what every activation asked for
+        _r.patch_dict(second, {"__reaktome_setitem__": lambda *args: None})
+        self.assertIn("trampoline", dict.pop.__doc__)
+        self.assertIn("trampoline", dict.update.__doc__)
+
+    def test_unpatch_all_restores_dict(self):
+        self.assertIn("trampoline", dict.update.__doc__)
+        _r.unpatch_all()
+        self.assertNotIn("trampoline", dict.update.__doc__)
+        self.d["a"] = 1
+        self.assertEqual(self.changes, [])
+
+
+class WatcherDictTestCase(ReaktomeDictTestCase):
+    backend = "watchers"
+    hooks_after_change = False
+
+    def setUp(self):
+        # start without trampolines left installed by earlier tests
+        _r.unpatch_all()
+        super().setUp()
+
+    def test_update_hook(self):
+        # updates arrive per pair; only clones into an empty dict are bulk
+        d, calls = {}, []
+        _r.patch_dict(d, {
+            "__reaktome_update__":
+                lambda self, key, old, new: calls.append(new),
+        })
+        d.update({"a": 1})
+        self.assertEqual([[("a", None, 1)]], calls)
+        _r.patch_dict(d, None)
+
+    def test_unpatch_all_restores_dict(self):
+        self.assertNotIn("trampoline", dict.update.__doc__)
+        _r.unpatch_all()
+        self.d["a"] = 1
+        self.assertEqual(self.changes, [])
+
+    def test_mixed_backends(self):
+        # a watched dict is reported by the watcher, whatever trampolines
+        # other activations installed
+        _r.dict_backend("trampolines")
+        other = {}
+        _r.patch_dict(other, {"__reaktome_delitem__": lambda *args: None})
+        self.d.update(a=1)
+        self.d.pop("a")
+        self.assertEqual(["a", "a"], [c.key for c in self.changes])
+
+    def test_specialized_store(self):
+        # STORE_SUBSCR_DICT never reaches a slot trampoline
+        for i in range(100):
+            self.d["a"] = i
+        self.assertEqual(100, len(self.changes))
+
+    def test_evicted_on_dealloc(self):
+        size = _r.side_table_size()
+        d = {}
+        _r.patch_dict(d, {})
+        self.assertEqual(size + 1, _r.side_table_size())
+        del d
+        self.assertEqual(size, _r.side_table_size())
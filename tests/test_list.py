@@ -7,6 +7,8 @@ from unittest.mock import MagicMock
 from pydantic import BaseModel
 from pydantic_collections import BaseCollectionModel
 
+import _reaktome as _r  # type: ignore
+
 from reaktome import Reaktome, reaktiv8, Changes
 
 
@@ -69,3 +71,300 @@ class ReaktomeListTestCase(unittest.TestCase):
 
     def test_deepcopy(self):
         deepcopy(self.list)
+
+    def test_side_table_evicted_on_dealloc(self):
+        size = _r.side_table_size()
+        lst = []
+        _r.patch_list(lst, {})
+        self.assertEqual(size + 1, _r.side_table_size())
+        del lst
+        self.assertEqual(size, _r.side_table_size())
+
+    def test_installs_what_hooks_need(self):
+        _r.unpatch_all()
+        lst = []
+        _r.patch_list(lst, {"__reaktome_reorder__": lambda *args: None})
+        self.assertIn("trampoline", list.sort.__doc__)
+        self.assertNotIn("trampoline", list.append.__doc__)
+        _r.patch_list(lst, None)
+
+    def test_setslice_hook(self):
+        calls, items = [], []
+        lst = [1, 2, 3]
+        _r.patch_list(lst, {
+            "__reaktome_setslice__": lambda *args: calls.append(args),
+            "__reaktome_setitem__": lambda *args: items.append(args),
+        })
+        lst.extend(iter([4, 5]))
+        lst[1:3] = ["a"]
+        del lst[:1]
+        self.assertEqual(["a", 4, 5], lst)
+        self.assertEqual([
+            (lst, 3, [], [4, 5]),
+            (lst, 1, [2, 3], ["a"]),
+            (lst, 0, [1], []),
+        ], calls)
+        self.assertEqual([], items)
+
+    def test_extend_without_setslice_hook(self):
+        items = []
+        lst = [1]
+        _r.patch_list(lst, {
+            "__reaktome_setitem__": lambda *args: items.append(args),
+        })
+        lst.extend(lst)
+        self.assertEqual([1, 1], lst)
+        self.assertEqual([(lst, 1, None, 1)], items)
+
+    def test_clear_hook(self):
+        calls, items = [], []
+        lst = [1, 2]
+        _r.patch_list(lst, {
+            "__reaktome_clear__": lambda *args: calls.append(args),
+            "__reaktome_delitem__": lambda *args: items.append(args),
+        })
+        lst.clear()
+        lst.clear()  # already empty, nothing to report
+        self.assertEqual([], lst)
+        self.assertEqual([(lst, None, [1, 2], None)], calls)
+        self.assertEqual([], items)
+
+    def test_reorder_hook(self):
+        calls = []
+        lst = ["b", "c", "a", "b"]
+        _r.patch_list(lst, {
+            "__reaktome_reorder__": lambda *args: calls.append(args),
+        })
+        lst.sort()
+        self.assertEqual(["a", "b", "b", "c"], lst)
+        lst.reverse()
+        self.assertEqual(["c", "b", "b", "a"], lst)
+        lst.sort(key=str.upper)
+        lst.sort()  # nothing moves, nothing to report
+        self.assertEqual([
+            (lst, "sort", None, [2, 0, 3, 1]),
+            (lst, "reverse", None, None),
+            (lst, "sort", None, [3, 1, 2, 0]),
+        ], calls)
+
+    def test_inplace_concat_and_repeat(self):
+        slices, repeats, items = [], [], []
+        lst = [1, 2]
+        _r.patch_list(lst, {
+            "__reaktome_setslice__": lambda *args: slices.append(args),
+            "__reaktome_repeat__": lambda *args: repeats.append(args),
+        })
+        lst += (3,)
+        lst *= 2
+        self.assertEqual([1, 2, 3, 1, 2, 3], lst)
+        self.assertEqual([(lst, 2, [], [3])], slices)
+        self.assertEqual([(lst, 2, None, None)], repeats)
+
+        other = ["a"]
+        _r.patch_list(other, {
+            "__reaktome_setitem__": lambda *args: items.append(args),
+        })
+        other *= 3
+        self.assertEqual([(other, 1, None, "a"), (other, 2, None, "a")],
+                         items)
+
+    def test_index_keys_shared(self):
+        keys = []
+        hooks = {"__reaktome_setitem__": lambda s, k, o, n: keys.append(k)}
+        first, second = [0] * 500, [0] * 500
+        _r.patch_list(first, hooks)
+        _r.patch_list(second, hooks)
+        first.append(1)
+        second.append(1)
+        self.assertEqual([500, 500], keys)
+        self.assertIs(keys[0], keys[1])
+
+    def test_list_install_kept_until_unpatch_all(self):
+        _r.unpatch_all()
+        self.assertEqual(0, _r.side_table_size())
+        self.assertNotIn("trampoline", list.append.__doc__)
+        calls = []
+        lst = []
+        _r.patch_list(lst, {"__reaktome_setitem__": lambda *args: calls.append(args)})
+        self.assertIn("trampoline", list.append.__doc__)
+        _r.patch_list(lst, None)
+        # list is static: reinstalling on every activation would wear out
+        # its version tags, so it stays patched but falls through
+        self.assertIn("trampoline", list.append.__doc__)
+        lst.append(1)
+        self.assertEqual([], calls)
+        _r.unpatch_all()
+        self.assertNotIn("trampoline", list.append.__doc__)
+
+    def test_list_install_kept_when_last_list_dies(self):
+        _r.unpatch_all()
+        lst = []
+        _r.patch_list(lst, {"__reaktome_setitem__": lambda *args: None})
+        del lst
+        self.assertEqual(0, _r.side_table_size())
+        self.assertIn("trampoline", list.append.__doc__)
+        _r.unpatch_all()
+        self.assertNotIn("trampoline", list.append.__doc__)
+
+    def test_many_activation_cycles(self):
+        # more cycles than 3.12 has version tags for static types
+        _r.unpatch_all()
+        hooks = {
+            "__reaktome_setitem__": lambda *args: None,
+            "__reaktome_delitem__": lambda *args: None,
+        }
+        plain = [0]
+        for _ in range(70_500):
+            lst = [1]
+            _r.patch_list(lst, hooks)
+            lst.append(2)
+            lst.insert(0, 1)
+            lst.pop()
+            _r.patch_list(lst, None)
+            plain.append(2)
+            plain.insert(0, 1)
+            plain.pop()
+        calls = []
+        lst = [1]
+        lst.append(4)
+        lst.insert(0, 3)
+        _r.patch_list(lst, {"__reaktome_setitem__": lambda *args: calls.append(args[1:])})
+        lst.append(5)
+        self.assertEqual([3, 1, 4, 5], lst)
+        self.assertEqual([(3, None, 5)], calls)
+        _r.unpatch_all()
+
+    def test_subclass_patched_alone(self):
+        _r.unpatch_all()
+
+        class Sub(list):
+            pass
+
+        calls = []
+        sub = Sub([1])
+        _r.patch_list(sub, {"__reaktome_setitem__": lambda *args: calls.append(args[1:])})
+        self.assertIn("trampoline", Sub.append.__doc__)
+        self.assertNotIn("trampoline", list.append.__doc__)
+        sub.append(2)
+        sub[0] = 3
+        self.assertEqual([(1, None, 2), (0, 1, 3)], calls)
+
+        _r.patch_list(sub, None)
+        self.assertNotIn("append", Sub.__dict__)
+        sub[0] = 4
+        self.assertEqual([4, 2], sub)
+        self.assertEqual(2, len(calls))
+
+    def test_subclass_overrides_forwarded(self):
+        _r.unpatch_all()
+
+        class Sub(list):
+            def __setitem__(self, key, value):
+                seen.append(key)
+                super().__setitem__(key, value)
+
+        seen, calls = [], []
+        sub = Sub([1])
+        _r.patch_list(sub, {"__reaktome_setitem__": lambda *args: calls.append(args[1:])})
+
+        class Later(Sub):  # inherits the trampolines
+            pass
+
+        sub[0] = 2
+        self.assertEqual([0], seen)
+        self.assertEqual([(0, 1, 2)], calls)
+
+        _r.patch_list(sub, None)
+        later = Later([1])
+        later[0] = 5
+        self.assertEqual([0, 0], seen)
+        self.assertEqual([5], later)
+
+    def test_subclass_method_overrides_run(self):
+        _r.unpatch_all()
+
+        class Sub(list):
+            def append(self, x):
+                super().append(x * 10)
+
+            def clear(self):
+                cleared.append(self)
+                super().clear()
+
+        class Later(Sub):
+            def extend(self, items):
+                super().extend(reversed(items))
+
+        cleared, calls = [], []
+        hooks = {
+            "__reaktome_setitem__": lambda *args: calls.append(args[1:]),
+            "__reaktome_delitem__": lambda *args: calls.append(args[1:]),
+        }
+        sub, sibling, later = Sub(), Sub(), Later()
+        _r.patch_list(sub, hooks)
+        _r.patch_list(later, hooks)
+        self.assertIs(Sub.__dict__["append"], Sub.append)
+        self.assertNotIn("trampoline", Sub.append.__doc__ or "")
+
+        sub.append(2)
+        sibling.append(5)
+        later.extend([1, 2])
+        sub.clear()
+        sibling.clear()
+        self.assertEqual([], sub)
+        self.assertEqual([], sibling)
+        self.assertEqual([2, 1], later)
+        self.assertEqual([sub, sibling], cleared)
+        self.assertEqual([(0, None, 20), (0, None, 2), (1, None, 1),
+                          (0, 20, None)], calls)
+
+        _r.patch_list(sub, None)
+        _r.patch_list(later, None)
+        self.assertNotIn("extend", Sub.__dict__)
+        later.append(3)
+        self.assertEqual([2, 1, 30], later)
+        self.assertEqual(4, len(calls))
+        # the wrappers borrowed on list stay until unpatch_all()
+        self.assertIn("trampoline", list.append.__doc__)
+        _r.unpatch_all()
+        self.assertNotIn("trampoline", list.append.__doc__)
+        self.assertNotIn("trampoline", list.clear.__doc__)
+
+    def test_list_and_subclass_installs_independent(self):
+        _r.unpatch_all()
+
+        class Sub(list):
+            pass
+
+        calls = []
+        hooks = {"__reaktome_setitem__": lambda *args: calls.append(args[1:])}
+        lst, sub = [0], Sub([0])
+        _r.patch_list(lst, hooks)
+        _r.patch_list(sub, hooks)
+        _r.patch_list(sub, None)
+        self.assertNotIn("append", Sub.__dict__)
+        lst.append(1)
+        sub.append(1)
+        self.assertEqual([(1, None, 1)], calls)
+        _r.patch_list(lst, None)
+
+    def test_stats(self):
+        calls = []
+        lst = []
+        _r.patch_list(lst, {
+            "__reaktome_setitem__": lambda *args: calls.append(args),
+        })
+        prev = _r.enable_stats()
+        try:
+            _r.reset_stats()
+            lst.append(1)
+            lst.append(2)
+            stats = _r.stats()[list]
+        finally:
+            _r.enable_stats(prev)
+            _r.reset_stats()
+        self.assertEqual(2, len(calls))
+        self.assertEqual(2, stats["ops"]["append"]["count"])
+        self.assertEqual(2, stats["hooks"]["__reaktome_setitem__"]["calls"])
+        self.assertEqual(0, stats["hooks"]["__reaktome_setitem__"]["errors"])
+        self.assertEqual({}, _r.stats())
@@ -0,0 +1,168 @@
+import gc
+import unittest
+import weakref
+
+import _reaktome as _r  # type: ignore
+
+from reaktome import (
+    reaktiv8, Changes, ReaktomeList, ReaktomeDict, ReaktomeSet,
+)
+
+
+def recorder(calls, *names):
+    "Hooks that append (hook name, key, old, new) to calls."
+    def hook(name):
+        return lambda self, key, old, new: calls.append((name, key, old, new))
+    return {f"__reaktome_{name}__": hook(name) for name in names}
+
+
+class Owner:
+    __reaktome_native__ = True
+
+    def __init__(self):
+        self.items = [[1], {"a": 1}]
+        self.tags = {"x"}
+
+
+class NativeContainerTestCase(unittest.TestCase):
+    def setUp(self):
+        _r.unpatch_all()
+        self.calls = []
+
+    def test_list(self):
+        lst = ReaktomeList([3, 1])
+        size = _r.side_table_size()
+        append = list.__dict__["append"]
+        _r.patch_list(lst, recorder(self.calls, "setitem", "delitem"))
+        lst.append(2)
+        lst[0] = 4
+        del lst[1]
+        lst += [5]
+        self.assertEqual([4, 2, 5], lst)
+        self.assertEqual([
+            ("setitem", 2, None, 2), ("setitem", 0, 3, 4),
+            ("delitem", 1, 1, None), ("setitem", 2, None, 5),
+        ], self.calls)
+        # nothing global: no side-table entry, list itself untouched
+        self.assertEqual(size, _r.side_table_size())
+        self.assertIs(append, list.__dict__["append"])
+
+    def test_dict(self):
+        d = ReaktomeDict(a=1)
+        _r.patch_dict(d, recorder(self.calls, "setitem", "delitem"))
+        d["b"] = 2
+        d |= {"c": 3}
+        d.pop("a")
+        self.assertEqual([
+            ("setitem", "b", None, 2), ("setitem", "c", None, 3),
+            ("delitem", "a", 1, None),
+        ], self.calls)
+
+    def test_subclass_item_overrides(self):
+        seen = []
+
+        class Dict(ReaktomeDict):
+            def __setitem__(self, key, value):
+                seen.append(key)
+                super().__setitem__(key, value)
+
+            def __delitem__(self, key):
+                seen.append(key)
+                super().__delitem__(key)
+
+        class List(ReaktomeList):
+            def __setitem__(self, key, value):
+                seen.append(key)
+                super().__setitem__(key, value)
+
+            def __delitem__(self, key):
+                seen.append(key)
+                super().__delitem__(key)
+
+        plain_d, plain_l = Dict(), List([0, 1])
+        plain_d["a"] = 1
+        del plain_d["a"]
+        plain_l[0] = 2
+        del plain_l[0]
+        self.assertEqual({}, plain_d)
+        self.assertEqual([1], plain_l)
+
+        d, lst = Dict(), List([0, 1])
+        _r.patch_dict(d, recorder(self.calls, "setitem", "delitem"))
+        _r.patch_list(lst, recorder(self.calls, "setitem", "delitem"))
+        d["a"] = 1
+        del d["a"]
+        lst[0] = 2
+        del lst[0]
+        lst.pop()  # not through __delitem__, as for list
+        self.assertEqual([], lst)
+        self.assertEqual(["a", "a", 0, 0] * 2, seen)
+        self.assertEqual([
+            ("setitem", "a", None, 1), ("delitem", "a", 1, None),
+            ("setitem", 0, 0, 2), ("delitem", 0, 2, None),
+            ("delitem", 0, 1, None),
+        ], self.calls)
+
+    def test_dict_after_patched_subclass(self):
+        self.addCleanup(_r.dict_backend, _r.dict_backend("trampolines"))
+
+        class Custom(dict):
+            def __setitem__(self, key, value):
+                super().__setitem__(key, value)
+
+        custom = Custom()
+        _r.patch_dict(custom, recorder([], "setitem"))
+        d = ReaktomeDict()
+        _r.patch_dict(d, recorder(self.calls, "setitem"))
+        d["x"] = 1
+        # plain dicts get their own trampoline alongside the subclass's
+        plain = {}
+        _r.patch_dict(plain, recorder(self.calls, "setitem"))
+        plain["y"] = 2
+        custom["z"] = 3
+        self.assertEqual({"z": 3}, custom)
+        self.assertEqual({"x": 1}, d)
+        self.assertEqual([
+            ("setitem", "x", None, 1), ("setitem", "y", None, 2),
+        ], self.calls)
+
+    def test_set(self):
+        s = ReaktomeSet([1])
+        _r.patch_set(s, recorder(self.calls, "additem", "discarditem"))
+        s.add(2)
+        s -= {1}
+        self.assertEqual({2}, s)
+        self.assertEqual([
+            ("additem", None, None, 2), ("discarditem", None, 1, None),
+        ], self.calls)
+
+    def test_deactivate(self):
+        lst = ReaktomeList()
+        _r.patch_list(lst, recorder(self.calls, "setitem"))
+        _r.patch_list(lst, None)
+        lst.append(1)
+        self.assertEqual([], self.calls)
+
+    def test_hooks_referencing_container_are_collected(self):
+        class Tracked(ReaktomeList):  # weakref-able
+            pass
+
+        lst = Tracked()
+        _r.patch_list(lst, {"__reaktome_setitem__": lambda *args: lst})
+        ref = weakref.ref(lst)
+        del lst
+        gc.collect()
+        self.assertIsNone(ref())
+
+    def test_reaktiv8_converts_owned_containers(self):
+        owner = Owner()
+        reaktiv8(owner)
+        changes = []
+        Changes.on(owner, changes.append)
+        self.assertIs(ReaktomeList, type(owner.items))
+        self.assertIs(ReaktomeList, type(owner.items[0]))
+        self.assertIs(ReaktomeDict, type(owner.items[1]))
+        self.assertIs(ReaktomeSet, type(owner.tags))
+        owner.items[0].append(2)
+        owner.items[1]["b"] = 2
+        self.assertEqual(2, len(changes))
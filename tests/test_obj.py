@@ -1,7 +1,11 @@
+import gc
+import tracemalloc
 import unittest
 
 from copy import deepcopy
 
+import _reaktome as _r  # type: ignore
+
 from reaktome import reaktiv8, Changes
 
 
@@ -28,5 +32,147 @@ class ReaktomeObjTestCase(unittest.TestCase):
         self.assertFalse(hasattr(self.obj, "name"))
         self.assertTrue(any(c.source == "attr" for c in self.changes))
 
+    def test_skip_noop(self):
+        _r.patch_obj(self.obj, {"__reaktome_skip_noop__": True})
+        self.obj.name = self.obj.name
+        self.assertEqual([], self.changes)
+        self.obj.name = "z"
+        self.assertEqual(1, len(self.changes))
+
+    def test_private_attrs_filtered(self):
+        self.obj._cache = 1
+        del self.obj._cache
+        self.obj.name = "z"
+        self.assertEqual(["name"], [c.key for c in self.changes])
+
+    def test_filter_before_snapshot(self):
+        class Bar:
+            reads = 0
+
+            @property
+            def prop(self):
+                Bar.reads += 1
+                return 0
+
+            @prop.setter
+            def prop(self, value):
+                pass
+
+        calls, bar = [], Bar()
+        _r.patch_obj(bar, {
+            "__reaktome_setattr__": lambda *args: calls.append(args[1]),
+            "__reaktome_filter__": ["x"],
+        })
+        bar.prop = 1
+        bar.x = 2
+        # the filtered name never had its old value read
+        self.assertEqual(0, Bar.reads)
+        self.assertEqual(["x"], calls)
+
+    def test_pre_hook_deactivates(self):
+        # The post hook is resolved again after a pre hook ran
+        obj, seen = Foo("a", "b"), []
+        _r.patch_obj(obj, {
+            "__setattr__": lambda *args: _r.patch_obj(obj, None),
+            "__reaktome_setattr__": lambda *args: seen.append(args),
+        })
+        obj.name = "c"
+        self.assertEqual("c", obj.name)
+        self.assertEqual([], seen)
+
+    def test_old_values(self):
+        class Bar:
+            default = 1
+
+            @property
+            def prop(self):
+                return "computed"
+
+            @prop.setter
+            def prop(self, value):
+                pass
+
+        calls = []
+        bar = Bar()
+        _r.patch_obj(bar, {
+            "__reaktome_setattr__":
+                lambda self, name, old, new: calls.append((name, old)),
+        })
+        bar.x = 1          # not set yet
+        bar.x = 2          # instance __dict__
+        bar.default = 3    # class attribute
+        bar.prop = 4       # data descriptor
+        self.assertEqual([
+            ("x", None), ("x", 1), ("default", 1), ("prop", "computed"),
+        ], calls)
+
+    def test_slots(self):
+        class Slotted:
+            __slots__ = ("x", "__y")
+
+        calls = []
+        obj = Slotted()
+        self.assertFalse(hasattr(obj, "__dict__"))
+        _r.patch_obj(obj, {
+            "__reaktome_setattr__":
+                lambda self, name, old, new: calls.append((name, old, new)),
+            "__reaktome_delattr__":
+                lambda self, name, old, new: calls.append((name, old, new)),
+        })
+        obj.x = 1
+        obj.x = 2
+        obj._Slotted__y = 3
+        del obj.x
+        self.assertEqual([
+            ("x", None, 1), ("x", 1, 2), ("_Slotted__y", None, 3),
+            ("x", 2, None),
+        ], calls)
+
+    def test_inline_attributes_not_materialized(self):
+        class Point:
+            def __init__(self):
+                self.x = 0
+                self.y = 0
+
+        points = [Point() for _ in range(1000)]
+        for point in points:
+            _r.patch_obj(point, {"__reaktome_setattr__": lambda *args: None})
+        tracemalloc.start()
+        try:
+            before = tracemalloc.get_traced_memory()[0]
+            for point in points:
+                point.x = 1
+            grown = tracemalloc.get_traced_memory()[0] - before
+        finally:
+            tracemalloc.stop()
+        # a __dict__ per instance would be tens of kilobytes
+        self.assertLess(grown, 8 * 1024)
+        self.assertNotIn(dict, [type(r) for r in gc.get_referents(points[0])])
+
+    def test_no_attribute_storage(self):
+        class Empty:
+            __slots__ = ()
+
+        with self.assertRaises(TypeError):
+            _r.patch_obj(Empty(), {})
+
     def test_deepcopy(self):
         deepcopy(self.obj)
+
+    def test_side_table_evicted_on_dealloc(self):
+        size = _r.side_table_size()
+        obj = Foo("a", "b")
+        _r.patch_obj(obj, {})
+        self.assertEqual(size + 1, _r.side_table_size())
+        del obj
+        self.assertEqual(size, _r.side_table_size())
+
+    def test_unpatched_when_last_instance_deactivated(self):
+        class Bar:
+            pass
+
+        bar = Bar()
+        _r.patch_obj(bar, {})
+        self.assertIn("__reaktome_type_patched__", Bar.__dict__)
+        del bar
+        self.assertNotIn("__reaktome_type_patched__", Bar.__dict__)
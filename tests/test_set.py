@@ -2,6 +2,8 @@ import unittest
 
 from copy import deepcopy
 
+import _reaktome as _r  # type: ignore
+
 from reaktome import reaktiv8, Changes
 
 
@@ -40,3 +42,34 @@ class ReaktomeSetTestCase(unittest.TestCase):
 
     def test_deepcopy(self):
         deepcopy(self.set)
+
+    def test_bulk_ops_trigger_hooks(self):
+        self.set.update(x for x in (1, 2, 3))
+        self.set -= {1}
+        self.set.intersection_update([2, 9])
+        self.set ^= {2, 4}
+        self.set.pop()
+        self.set.add(5)
+        self.set.clear()
+        self.assertEqual(set(), self.set)
+        # +1 +2 +3, -1, -3, -2 +4, -4 (pop), +5, -5 (clear)
+        self.assertEqual(10, len(self.changes))
+
+    def test_delta_hook(self):
+        calls = []
+        s = {1, 2, 3}
+        _r.patch_set(s, {
+            "__reaktome_delta__":
+                lambda self, key, removed, added: calls.append((removed, added)),
+        })
+        s.update([3, 4], (5,))
+        s.difference_update({1, 9})
+        s.symmetric_difference_update([2, 6, 6])
+        s.update([4])  # nothing changes, nothing to report
+        self.assertEqual({3, 4, 5, 6}, s)
+        self.assertEqual([
+            (set(), {4, 5}),
+            ({1}, set()),
+            ({2}, {6}),
+        ], calls)
+        _r.patch_set(s, None)